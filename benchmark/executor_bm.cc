@@ -0,0 +1,84 @@
+//
+// benchmark/executor_bm.cc
+//
+// Fine-grained parallel evaluation: ThreadJoinLinks with many small
+// children, run on the shared executor (user-050), against starting a
+// thread per child and joining it, which is what was done before.
+//
+// Usage: executor_bm [nevals]
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencog/atoms/atom_types/atom_names.h>
+#include <opencog/atoms/execution/EvaluationLink.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "timer.h"
+
+using namespace opencog;
+
+// A small conjunction, that evaluates to true.
+static Handle make_child(AtomSpace& as)
+{
+	return as.add_link(AND_LINK, as.add_link(TRUE_LINK),
+		as.add_link(NOT_LINK, as.add_link(FALSE_LINK)));
+}
+
+// A ThreadJoinLink of `width` copies of the child.
+static Handle make_join(AtomSpace& as, size_t width)
+{
+	return as.add_link(THREAD_JOIN_LINK, HandleSeq(width, make_child(as)));
+}
+
+// The baseline: one thread for each child.
+static bool thread_per_child(AtomSpace* as, const Handle& join)
+{
+	const HandleSeq& oset = join->getOutgoingSet();
+	std::vector<char> res(oset.size());
+	std::vector<std::thread> thr;
+	for (size_t i = 0; i < oset.size(); i++)
+		thr.push_back(std::thread([as, &oset, &res, i]() {
+			res[i] = EvaluationLink::crisp_evaluate(as, oset[i], true);
+		}));
+	for (std::thread& t : thr) t.join();
+	for (char r : res)
+		if (not r) return false;
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = arg_size(argc, argv, 10000);
+
+	AtomSpace as;
+	for (size_t width : {2, 8, 32})
+	{
+		Handle join(make_join(as, width));
+		size_t nops = n * width;
+
+		std::string name = "executor, width " + std::to_string(width);
+		report(name.c_str(), nops, timeit([&]() {
+			for (size_t i = 0; i < n; i++)
+				EvaluationLink::crisp_evaluate(&as, join, true);
+		}));
+
+		name = "thread per child, width " + std::to_string(width);
+		report(name.c_str(), nops, timeit([&]() {
+			for (size_t i = 0; i < n; i++)
+				thread_per_child(&as, join);
+		}));
+	}
+
+	// Nested joins: every child is itself a join, so that the workers
+	// wait on work that they have handed out.
+	Handle nested(as.add_link(THREAD_JOIN_LINK,
+		HandleSeq(8, make_join(as, 8))));
+	size_t nnest = std::max((size_t) 1, n / 8);
+	report("executor, nested 8x8", nnest * 64, timeit([&]() {
+		for (size_t i = 0; i < nnest; i++)
+			EvaluationLink::crisp_evaluate(&as, nested, true);
+	}));
+}
@@ -0,0 +1,81 @@
+//
+// benchmark/hash_bm.cc
+//
+// The atom content hash: how fast it is, and how well it spreads over
+// the low bits that the hash tables index by (user-047). The hash is
+// chosen at build time; build once with -DFAST_CONTENT_HASH=ON and
+// once without, and compare the output.
+//
+// Usage: hash_bm [natoms]
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/atom_types/atom_names.h>
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "timer.h"
+
+using namespace opencog;
+
+// The fraction of the 2^bits buckets that are used, over that
+// expected of a uniform hash.
+static double spread(const std::vector<ContentHash>& hashes, size_t bits)
+{
+	size_t nbuckets = 1UL << bits;
+	std::vector<bool> used(nbuckets, false);
+	size_t nused = 0;
+	for (ContentHash h : hashes)
+	{
+		size_t b = h & (nbuckets - 1);
+		if (not used[b]) { used[b] = true; nused++; }
+	}
+	double m = nbuckets;
+	double expect = m * (1.0 - pow(1.0 - 1.0 / m, hashes.size()));
+	return nused / expect;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = arg_size(argc, argv, 1000000);
+
+#ifdef FAST_CONTENT_HASH
+	printf("Content hash: fast\n");
+#else
+	printf("Content hash: default\n");
+#endif
+
+	std::vector<std::string> names;
+	for (size_t i = 0; i < n; i++)
+		names.push_back("concept " + std::to_string(i));
+
+	std::vector<ContentHash> hashes(n);
+	report("Node::content_hash", n, timeit([&]() {
+		for (size_t i = 0; i < n; i++)
+			hashes[i] = Node::content_hash(CONCEPT_NODE, names[i]);
+	}));
+	printf("%-40s %10.3f\n", "node spread, 16 low bits", spread(hashes, 16));
+
+	AtomSpace as;
+	HandleSeq nodes;
+	for (const std::string& s : names)
+		nodes.push_back(as.add_node(CONCEPT_NODE, std::string(s)));
+
+	std::vector<HandleSeq> osets;
+	for (size_t i = 0; i < n; i++)
+		osets.push_back({nodes[i], nodes[(i * 7 + 1) % n]});
+
+	report("Link::content_hash", n, timeit([&]() {
+		for (size_t i = 0; i < n; i++)
+			hashes[i] = Link::content_hash(LIST_LINK, osets[i]);
+	}));
+	printf("%-40s %10.3f\n", "link spread, 16 low bits", spread(hashes, 16));
+
+	report("add_link", n, timeit([&]() {
+		for (size_t i = 0; i < n; i++)
+			as.add_link(LIST_LINK, HandleSeq(osets[i]));
+	}));
+}
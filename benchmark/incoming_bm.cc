@@ -0,0 +1,115 @@
+//
+// benchmark/incoming_bm.cc
+//
+// Incoming-set reads on a hub atom: the lock-free walk of
+// visit_incoming(), against copying the set out with getIncomingSet(),
+// with and without a writer adding and removing links to the hub at
+// the same time (user-038).
+//
+// Usage: incoming_bm [nlinks] [nthreads]
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencog/atoms/atom_types/atom_names.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "timer.h"
+
+using namespace opencog;
+
+static size_t walk(const Handle& hub)
+{
+	size_t cnt = 0;
+	hub->visit_incoming([&](const Handle& h)->bool {
+		cnt += h->get_arity();
+		return false;
+	});
+	return cnt;
+}
+
+static size_t copy(const Handle& hub)
+{
+	size_t cnt = 0;
+	for (const Handle& h : hub->getIncomingSet())
+		cnt += h->get_arity();
+	return cnt;
+}
+
+// Read the incoming set `nreads` times in each of `nthreads` threads,
+// while, if `churn` is set, another thread keeps changing it.
+template <typename Reader>
+static double readers(AtomSpace& as, const Handle& hub, size_t nthreads,
+                      size_t nreads, bool churn, Reader read)
+{
+	std::atomic_bool done(false);
+	std::thread writer;
+	if (churn)
+		writer = std::thread([&]() {
+			size_t i = 0;
+			while (not done)
+			{
+				Handle n(as.add_node(PREDICATE_NODE, "churn " + std::to_string(i++ % 64)));
+				Handle l(as.add_link(LIST_LINK, hub, n));
+				as.extract_atom(l);
+			}
+		});
+
+	std::atomic<size_t> sink(0);
+	double secs = timeit([&]() {
+		std::vector<std::thread> thr;
+		for (size_t t = 0; t < nthreads; t++)
+			thr.push_back(std::thread([&]() {
+				size_t cnt = 0;
+				for (size_t i = 0; i < nreads; i++)
+					cnt += read(hub);
+				sink += cnt;
+			}));
+		for (std::thread& t : thr) t.join();
+	});
+
+	done = true;
+	if (churn) writer.join();
+	return secs;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = arg_size(argc, argv, 100000);
+	size_t nthreads = 4;
+	if (2 < argc) nthreads = strtoul(argv[2], nullptr, 10);
+
+	AtomSpace as;
+	Handle hub(as.add_node(CONCEPT_NODE, "hub"));
+	for (size_t i = 0; i < n; i++)
+		as.add_link(i%2 ? LIST_LINK : SET_LINK, hub,
+			as.add_node(CONCEPT_NODE, std::to_string(i)));
+
+	// Enough reads for each run to take a measurable time.
+	size_t nreads = std::max((size_t) 1, 10000000 / n);
+	size_t nops = nreads * nthreads * n;
+
+	report("visit_incoming", nops,
+		readers(as, hub, nthreads, nreads, false, walk));
+	report("getIncomingSet", nops,
+		readers(as, hub, nthreads, nreads, false, copy));
+	report("visit_incoming, with writer", nops,
+		readers(as, hub, nthreads, nreads, true, walk));
+	report("getIncomingSet, with writer", nops,
+		readers(as, hub, nthreads, nreads, true, copy));
+
+	// The cost of keeping the snapshot current: add and remove links
+	// to the hub, reading the set after every change.
+	size_t nchg = std::min(n, (size_t) 100000);
+	report("add link and read", nchg, timeit([&]() {
+		for (size_t i = 0; i < nchg; i++)
+		{
+			as.add_link(MEMBER_LINK, hub,
+				as.add_node(CONCEPT_NODE, std::to_string(i)));
+			walk(hub);
+		}
+	}));
+}
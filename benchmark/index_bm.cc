@@ -0,0 +1,140 @@
+//
+// benchmark/index_bm.cc
+//
+// The atom index: the open-addressing FlatAtomSet that the AtomTable
+// uses, against the std::unordered_multimap<ContentHash, Handle> that
+// it replaced (user-048), kept here as the baseline. Both are driven
+// the same way the AtomTable drives them: insert, find by hash and
+// atom equality, erase.
+//
+// Usage: index_bm [natoms]
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/atom_types/atom_names.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atomspace/FlatAtomSet.h>
+
+#include "timer.h"
+
+using namespace opencog;
+
+// Counts the bytes held by the baseline multimap.
+static size_t allocated = 0;
+
+template <typename T>
+struct CountingAllocator
+{
+	typedef T value_type;
+	CountingAllocator(void) {}
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>&) {}
+
+	T* allocate(size_t n)
+	{
+		allocated += n * sizeof(T);
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T* p, size_t n)
+	{
+		allocated -= n * sizeof(T);
+		std::allocator<T>().deallocate(p, n);
+	}
+	template <typename U>
+	bool operator==(const CountingAllocator<U>&) const { return true; }
+	template <typename U>
+	bool operator!=(const CountingAllocator<U>&) const { return false; }
+};
+
+typedef std::unordered_multimap<ContentHash, Handle,
+	std::hash<ContentHash>, std::equal_to<ContentHash>,
+	CountingAllocator<std::pair<const ContentHash, Handle>>> AtomMultiMap;
+
+static AtomMultiMap::const_iterator
+find_entry(const AtomMultiMap& m, const Handle& h)
+{
+	auto range = m.equal_range(h->get_hash());
+	for (auto it = range.first; it != range.second; it++)
+		if (*it->second == *h) return it;
+	return m.end();
+}
+
+static FlatAtomSet::const_iterator
+find_entry(const FlatAtomSet& s, const Handle& h)
+{
+	return s.find_if(h->get_hash(),
+		[&](const Handle& o) { return *o == *h; });
+}
+
+template <typename Index>
+static void run(const char* label, Index& index,
+                const HandleSeq& atoms, const HandleSeq& misses)
+{
+	size_t n = atoms.size();
+	std::string name;
+
+	name = std::string("insert, ") + label;
+	report(name.c_str(), n, timeit([&]() {
+		for (const Handle& h : atoms)
+			index.insert({h->get_hash(), h});
+	}));
+
+	size_t found = 0;
+	name = std::string("find (hit), ") + label;
+	report(name.c_str(), n, timeit([&]() {
+		for (const Handle& h : atoms)
+			if (find_entry(index, h) != index.end()) found++;
+	}));
+
+	name = std::string("find (miss), ") + label;
+	report(name.c_str(), n, timeit([&]() {
+		for (const Handle& h : misses)
+			if (find_entry(index, h) != index.end()) found++;
+	}));
+	if (found != n) printf("Error: found %zu of %zu atoms\n", found, n);
+
+	name = std::string("iterate, ") + label;
+	size_t cnt = 0;
+	report(name.c_str(), n, timeit([&]() {
+		for (const auto& pr : index)
+			cnt += (nullptr != pr.second);
+	}));
+
+	// Erase half, then insert them again, as churn would.
+	name = std::string("erase and insert, ") + label;
+	report(name.c_str(), n, timeit([&]() {
+		for (size_t i = 0; i < n; i += 2)
+			index.erase(find_entry(index, atoms[i]));
+		for (size_t i = 0; i < n; i += 2)
+			index.insert({atoms[i]->get_hash(), atoms[i]});
+	}));
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = arg_size(argc, argv, 1000000);
+
+	HandleSeq atoms, misses;
+	for (size_t i = 0; i < n; i++)
+	{
+		atoms.push_back(createNode(CONCEPT_NODE, "concept " + std::to_string(i)));
+		misses.push_back(createNode(PREDICATE_NODE, "concept " + std::to_string(i)));
+	}
+
+	{
+		AtomMultiMap index;
+		run("multimap", index, atoms, misses);
+		printf("%-40s %10.1f bytes/atom\n", "memory, multimap",
+		       (double) allocated / n);
+	}
+
+	{
+		FlatAtomSet index;
+		run("flat", index, atoms, misses);
+		printf("%-40s %10.1f bytes/atom\n", "memory, flat",
+		       (double) index.memory_usage() / n);
+	}
+}
@@ -0,0 +1,89 @@
+//
+// benchmark/lookup_bm.cc
+//
+// Atom lookup: adding and getting atoms that are already in the
+// atomspace, which should not construct a new atom (user-033), and
+// getting atoms from deeply nested atomspaces (user-034).
+//
+// Usage: lookup_bm [natoms]
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/atom_types/atom_names.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "timer.h"
+
+using namespace opencog;
+
+int main(int argc, char* argv[])
+{
+	size_t n = arg_size(argc, argv, 1000000);
+
+	std::vector<std::string> names;
+	for (size_t i = 0; i < n; i++)
+		names.push_back("concept " + std::to_string(i));
+
+	AtomSpace as;
+	report("add_node (new)", n, timeit([&]() {
+		for (const std::string& s : names)
+			as.add_node(CONCEPT_NODE, std::string(s));
+	}));
+
+	report("add_node (existing)", n, timeit([&]() {
+		for (const std::string& s : names)
+			as.add_node(CONCEPT_NODE, std::string(s));
+	}));
+
+	report("get_node (hit)", n, timeit([&]() {
+		for (const std::string& s : names)
+			as.get_node(CONCEPT_NODE, std::string(s));
+	}));
+
+	report("get_node (miss)", n, timeit([&]() {
+		for (const std::string& s : names)
+			as.get_node(PREDICATE_NODE, std::string(s));
+	}));
+
+	Handle a(as.get_node(CONCEPT_NODE, std::string(names[0])));
+	HandleSeq links;
+	for (size_t i = 1; i < n; i++)
+		links.push_back(as.add_link(LIST_LINK, a,
+			as.get_node(CONCEPT_NODE, std::string(names[i]))));
+
+	report("get_link (hit)", n - 1, timeit([&]() {
+		for (const Handle& h : links)
+			as.get_link(LIST_LINK, HandleSeq(h->getOutgoingSet()));
+	}));
+
+	// Nested atomspaces. The atoms live at the bottom; every lookup
+	// from the top has to search the whole stack of frames.
+	size_t nlook = std::min(n, (size_t) 100000);
+	for (size_t depth : {1, 5, 10, 25, 50})
+	{
+		std::vector<AtomSpace*> stack;
+		AtomSpace* top = &as;
+		for (size_t d = 0; d < depth; d++)
+		{
+			top = new AtomSpace(top);
+			stack.push_back(top);
+		}
+
+		std::string name = "get_node, depth " + std::to_string(depth);
+		report(name.c_str(), nlook, timeit([&]() {
+			for (size_t i = 0; i < nlook; i++)
+				top->get_node(CONCEPT_NODE, std::string(names[i]));
+		}));
+
+		name = "get_node (miss), depth " + std::to_string(depth);
+		report(name.c_str(), nlook, timeit([&]() {
+			for (size_t i = 0; i < nlook; i++)
+				top->get_node(PREDICATE_NODE, std::string(names[i]));
+		}));
+
+		for (auto it = stack.rbegin(); it != stack.rend(); it++)
+			delete *it;
+	}
+}
@@ -0,0 +1,50 @@
+//
+// benchmark/timer.h
+//
+// Timing helpers shared by the benchmarks.
+
+#ifndef _OPENCOG_BENCHMARK_TIMER_H
+#define _OPENCOG_BENCHMARK_TIMER_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+// Seconds taken by `func()`.
+template <typename Function>
+double timeit(Function func)
+{
+	auto start = std::chrono::steady_clock::now();
+	func();
+	std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+	return d.count();
+}
+
+// Print one result line: the name, the time per operation, and the
+// rate, so that the output of two builds can be put side by side.
+static inline void report(const char* name, size_t nops, double secs)
+{
+	printf("%-40s %10.1f ns/op %12.0f ops/sec\n",
+	       name, 1.0e9 * secs / nops, nops / secs);
+}
+
+// The problem size, from the first argument, if any.
+static inline size_t arg_size(int argc, char* argv[], size_t dflt)
+{
+	if (1 < argc) return strtoul(argv[1], nullptr, 10);
+	return dflt;
+}
+
+// Resident set size, in bytes; zero where /proc is not available.
+static inline size_t rss_bytes(void)
+{
+	size_t pages = 0, resident = 0;
+	FILE* f = fopen("/proc/self/statm", "r");
+	if (nullptr == f) return 0;
+	if (2 != fscanf(f, "%zu %zu", &pages, &resident)) resident = 0;
+	fclose(f);
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+#endif // _OPENCOG_BENCHMARK_TIMER_H
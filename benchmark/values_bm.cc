@@ -0,0 +1,150 @@
+//
+// benchmark/values_bm.cc
+//
+// Values on atoms: dense float features kept in a value column, against
+// a FloatValue on each atom (user-045), and getValue() latency with
+// several keys per atom, with and without concurrent readers (user-046).
+//
+// Usage: values_bm [natoms] [width]
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencog/atoms/atom_types/atom_names.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "timer.h"
+
+using namespace opencog;
+
+static HandleSeq make_atoms(AtomSpace& as, size_t n)
+{
+	HandleSeq atoms;
+	for (size_t i = 0; i < n; i++)
+		atoms.push_back(as.add_node(CONCEPT_NODE, "word " + std::to_string(i)));
+	return atoms;
+}
+
+static void set_features(const HandleSeq& atoms, const Handle& key,
+                         size_t width)
+{
+	std::vector<double> vec(width);
+	for (size_t i = 0; i < atoms.size(); i++)
+	{
+		for (size_t j = 0; j < width; j++) vec[j] = (i + j) % 17;
+		atoms[i]->setValue(key, createFloatValue(vec));
+	}
+}
+
+// Features: the same vectors, stored both ways.
+static void features(size_t n, size_t width)
+{
+	std::vector<double> query(width, 0.5);
+	std::vector<double> prods;
+
+	{
+		AtomSpace as;
+		Handle key(as.add_node(PREDICATE_NODE, "embedding"));
+		HandleSeq atoms(make_atoms(as, n));
+
+		size_t before = rss_bytes();
+		report("set, per atom", n, timeit([&]() {
+			set_features(atoms, key, width);
+		}));
+		printf("%-40s %10.1f bytes/atom\n", "memory, per atom",
+		       (double) (rss_bytes() - before) / n);
+
+		report("dot, per atom", n, timeit([&]() {
+			prods.resize(n);
+			for (size_t i = 0; i < n; i++)
+			{
+				const std::vector<double>& v =
+					FloatValueCast(atoms[i]->getValue(key))->value();
+				double s = 0.0;
+				for (size_t j = 0; j < width; j++) s += v[j] * query[j];
+				prods[i] = s;
+			}
+		}));
+	}
+
+	{
+		AtomSpace as;
+		Handle key(as.add_node(PREDICATE_NODE, "embedding"));
+		HandleSeq atoms(make_atoms(as, n));
+		ValueColumnPtr col(as.add_value_column(CONCEPT_NODE, key, width));
+
+		size_t before = rss_bytes();
+		report("set, column", n, timeit([&]() {
+			set_features(atoms, key, width);
+		}));
+		printf("%-40s %10.1f bytes/atom\n", "memory, column",
+		       (double) (rss_bytes() - before) / n);
+
+		HandleSeq rows;
+		report("dot, column", n, timeit([&]() {
+			col->dot(query, rows, prods);
+		}));
+
+		report("getValue, column", n, timeit([&]() {
+			for (const Handle& h : atoms)
+				FloatValueCast(h->getValue(key))->value();
+		}));
+	}
+}
+
+// Lookups: `nkeys` values on every atom, read from `nthreads` threads.
+static void lookups(size_t n, size_t nkeys, size_t nthreads)
+{
+	AtomSpace as;
+	HandleSeq atoms(make_atoms(as, n));
+	HandleSeq keys;
+	for (size_t k = 0; k < nkeys; k++)
+		keys.push_back(as.add_node(PREDICATE_NODE, "key " + std::to_string(k)));
+
+	for (const Handle& h : atoms)
+	{
+		h->setTruthValue(createSimpleTruthValue(0.5, 0.5));
+		for (const Handle& k : keys)
+			h->setValue(k, createFloatValue(1.0));
+	}
+
+	std::string name = "getValue, " + std::to_string(nkeys) + " keys, " +
+		std::to_string(nthreads) + " threads";
+	report(name.c_str(), n * nkeys * nthreads, timeit([&]() {
+		std::vector<std::thread> thr;
+		for (size_t t = 0; t < nthreads; t++)
+			thr.push_back(std::thread([&]() {
+				for (const Handle& h : atoms)
+					for (const Handle& k : keys)
+						h->getValue(k);
+			}));
+		for (std::thread& t : thr) t.join();
+	}));
+
+	name = "getTruthValue, " + std::to_string(nthreads) + " threads";
+	report(name.c_str(), n * nthreads, timeit([&]() {
+		std::vector<std::thread> thr;
+		for (size_t t = 0; t < nthreads; t++)
+			thr.push_back(std::thread([&]() {
+				for (const Handle& h : atoms)
+					h->getTruthValue();
+			}));
+		for (std::thread& t : thr) t.join();
+	}));
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = arg_size(argc, argv, 100000);
+	size_t width = 64;
+	if (2 < argc) width = strtoul(argv[2], nullptr, 10);
+
+	features(n, width);
+
+	for (size_t nkeys : {1, 4, 16})
+		for (size_t nthreads : {1, 4})
+			lookups(n, nkeys, nthreads);
+}
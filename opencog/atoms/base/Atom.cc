@@ -24,6 +24,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <set>
 #include <sstream>
 
@@ -105,6 +106,9 @@ Atom::~Atom()
     }
 #endif
     drop_incoming_set();
+
+    // Nobody else can be looking at the values any more.
+    delete _values.load();
 }
 
 // ==============================================================
@@ -135,10 +139,8 @@ void Atom::setTruthValue(const TruthValuePtr& newTV)
     // http://www.boost.org/doc/libs/1_53_0/libs/smart_ptr/shared_ptr.htm#ThreadSafety
     setValue (truth_key(), ValueCast(newTV));
 
-    if (_atom_space != nullptr) {
-        TVCHSigl& tvch = _atom_space->_atom_table.TVChangedSignal();
-        tvch.emit(get_handle(), oldTV, newTV);
-    }
+    if (_atom_space != nullptr)
+        _atom_space->_atom_table.tvChanged(get_handle(), oldTV, newTV);
 }
 
 TruthValuePtr Atom::getTruthValue() const
@@ -149,21 +151,110 @@ TruthValuePtr Atom::getTruthValue() const
 }
 
 // ==============================================================
+
+// Keys are nearly always the very same atoms, so compare addresses
+// first. A copy of a key is still the same key; but the full compare
+// is only made when the hashes, cached in the atoms, agree.
+static inline bool same_key(const Handle& a, const Handle& b)
+{
+	return a == b or (a->get_hash() == b->get_hash() and *a == *b);
+}
+
+static inline bool is_truth_key(const Handle& key)
+{
+	return same_key(key, truth_key());
+}
+
+ValuePtr Atom::ValueSlots::find(const Handle& key, bool is_tv) const
+{
+	if (is_tv) return _tv;
+
+	// Pointer compares first; the other compares are seldom needed.
+	for (const auto& kv : _kvs)
+		if (kv.first == key) return kv.second;
+	for (const auto& kv : _kvs)
+		if (same_key(kv.first, key)) return kv.second;
+	return nullptr;
+}
+
+/// Install a copy of the value slots, with the value at `key` changed.
+/// The caller must hold _mtx. Returns true if the old slots were handed
+/// to the epoch manager; the caller should then call reclaim(), after
+/// releasing the lock.
+bool Atom::put_value(const Handle& key, const ValuePtr& value)
+{
+	const ValueSlots* old = _values.load();
+	bool is_tv = is_truth_key(key);
+
+	// Removing a value that is not there is a no-op.
+	if (nullptr == value and
+	    (nullptr == old or nullptr == old->find(key, is_tv)))
+		return false;
+
+	ValueSlots* neu = old ? new ValueSlots(*old) : new ValueSlots();
+	if (is_tv)
+		neu->_tv = value;
+	else
+	{
+		auto it = std::find_if(neu->_kvs.begin(), neu->_kvs.end(),
+			[&](const std::pair<Handle, ValuePtr>& kv)->bool {
+				return same_key(kv.first, key); });
+
+		if (neu->_kvs.end() == it)
+			neu->_kvs.emplace_back(key, value);
+		else if (nullptr != value)
+			it->second = value;
+		else
+		{
+			*it = std::move(neu->_kvs.back());
+			neu->_kvs.pop_back();
+		}
+	}
+
+	if (nullptr == neu->_tv and neu->_kvs.empty())
+	{
+		delete neu;
+		neu = nullptr;
+	}
+
+	_values.store(neu);
+	if (nullptr == old) return false;
+	epoch_manager().retire(old);
+	return true;
+}
+
 /// Setting values associated with this atom.
 /// If the value is a null pointer, then the key is removed.
 void Atom::setValue(const Handle& key, const ValuePtr& value)
 {
-	std::lock_guard<std::mutex> lck(_mtx);
-	if (nullptr != value)
-	{
-		_values[key] = value;
-	}
-	else
+	// Values of the right shape go into the value column, if the
+	// atomspace keeps one for this type and key.
+	AtomSpace* as = _atom_space;
+	ValueColumnPtr col;
+	if (as and as->_atom_table.haveValueColumn())
+		col = as->_atom_table.getValueColumn(_type, key);
+
+	bool retired;
 	{
-		// If the value is a null pointer, then the value at
-		// this key should be blanked out, i.e. unset.
-		_values.erase(key);
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (col and col->store(get_handle(), value))
+		{
+			retired = put_value(key, nullptr);
+		}
+		else
+		{
+			// If the value is a null pointer, then the value at
+			// this key should be blanked out, i.e. unset.
+			if (col) col->remove(get_handle());
+			retired = put_value(key, value);
+		}
 	}
+	if (retired) reclaim();
+
+	// Keep the value indexes, if any, up to date. This must be done
+	// without holding the lock, as the index reads the value back.
+	if (as and as->_atom_table.haveValueIndex())
+		as->_atom_table.valueChanged(get_handle(), key);
 }
 
 ValuePtr Atom::getValue(const Handle& key) const
@@ -177,25 +268,74 @@ ValuePtr Atom::getValue(const Handle& key) const
     // dereference can return a raw pointer to an object that has been
     // deconstructed.  The AtomSpaceAsyncUTest will hit this, as will
     // the multi-threaded async atom store in the SQL peristance backend.
-    // Furthermore, we must make a copy while holding the lock! Got that?
+    // The copy is made either while holding the lock, or while inside
+    // an epoch guard, which keeps the slots from being freed.
 
-    ValuePtr pap;
-    std::lock_guard<std::mutex> lck(_mtx);
-    auto pr = _values.find(key);
-    if (_values.end() != pr) pap = pr->second;
-    return pap;
+    bool is_tv = is_truth_key(key);
+
+    // The column is looked at while holding the lock, so that a value
+    // that setValue() is moving into the column is never missed.
+    AtomSpace* as = _atom_space;
+    if (not is_tv and as and as->_atom_table.haveValueColumn())
+    {
+        ValueColumnPtr col(as->_atom_table.getValueColumn(_type, key));
+        if (col)
+        {
+            std::lock_guard<std::mutex> lck(_mtx);
+            ValuePtr pap(col->fetch(this));
+            if (pap) return pap;
+            const ValueSlots* vs = _values.load();
+            return vs ? vs->find(key, false) : nullptr;
+        }
+    }
+
+    EpochGuard guard;
+    if (not guard.active())
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        const ValueSlots* vs = _values.load();
+        return vs ? vs->find(key, is_tv) : nullptr;
+    }
+
+    const ValueSlots* vs = _values.load();
+    return vs ? vs->find(key, is_tv) : nullptr;
 }
 
 HandleSet Atom::getKeys() const
 {
     HandleSet keyset;
-    std::lock_guard<std::mutex> lck(_mtx);
-    for (const auto& pr : _values)
-        keyset.insert(pr.first);
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        const ValueSlots* vs = _values.load();
+        if (vs)
+        {
+            if (vs->_tv) keyset.insert(truth_key());
+            for (const auto& kv : vs->_kvs)
+                keyset.insert(kv.first);
+        }
+    }
+
+    AtomSpace* as = _atom_space;
+    if (as and as->_atom_table.haveValueColumn())
+        for (const ValueColumnPtr& col :
+             as->_atom_table.getValueColumns(_type))
+            if (col->holds(this)) keyset.insert(col->get_key());
 
     return keyset;
 }
 
+bool Atom::haveValues() const
+{
+    if (nullptr != _values.load()) return true;
+
+    AtomSpace* as = _atom_space;
+    if (as and as->_atom_table.haveValueColumn())
+        for (const ValueColumnPtr& col :
+             as->_atom_table.getValueColumns(_type))
+            if (col->holds(this)) return true;
+    return false;
+}
+
 void Atom::copyValues(const Handle& other)
 {
     HandleSet okeys(other->getKeys());
@@ -306,16 +446,136 @@ void Atom::keep_incoming_set()
 void Atom::drop_incoming_set()
 {
     if (nullptr == _incoming_set) return;
+    bool retired;
+    {
+        std::lock_guard<std::mutex> lck (_mtx);
+        retired = drop_snapshot();
+        // _incoming_set->_iset.clear();
+        _incoming_set = nullptr;
+    }
+    if (retired) reclaim();
+}
+
+/// Return the read-only copy of the incoming set, making it first,
+/// if need be. The caller must be inside an active EpochGuard, so
+/// that the copy is not freed from under it.
+const Atom::InSet::Snapshot* Atom::incoming_snapshot() const
+{
+    InSet* iset = _incoming_set.get();
+    const InSet::Snapshot* snap = iset->_snap.load();
+    if (snap) return snap;
+
     std::lock_guard<std::mutex> lck (_mtx);
-    // _incoming_set->_iset.clear();
-    _incoming_set = nullptr;
+    snap = iset->_snap.load();
+    if (snap) return snap;
+
+    InSet::Snapshot* neu = new InSet::Snapshot();
+    for (const auto& bucket : iset->_iset)
+    {
+        auto chunks = std::make_shared<std::vector<InSet::Chunk>>();
+        HandleSeq hs;
+        for (const WinkPtr& w : bucket.second)
+        {
+            Handle h(w.lock());
+            if (nullptr == h) continue;
+            hs.emplace_back(h);
+            if (InSet::Snapshot::CHUNK == hs.size())
+            {
+                chunks->emplace_back(std::make_shared<const HandleSeq>(std::move(hs)));
+                hs.clear();
+            }
+        }
+        if (not hs.empty())
+            chunks->emplace_back(std::make_shared<const HandleSeq>(std::move(hs)));
+        if (not chunks->empty())
+            neu->_by_type.emplace(bucket.first, chunks);
+    }
+    iset->_snap.store(neu);
+    return neu;
+}
+
+/// Add the link to, or remove it from, the read-only copy of the
+/// incoming set, if there is one. The new copy shares all of the
+/// old one, except for the bucket of the link type, and the chunk
+/// in it that changed. The caller must hold _mtx, and must only
+/// call this if the link was actually added or removed. Returns
+/// true if the old copy was retired; the caller should then call
+/// reclaim(), after releasing the lock.
+bool Atom::update_snapshot(const Handle& a, bool add)
+{
+    const InSet::Snapshot* old = _incoming_set->_snap.load();
+    if (nullptr == old) return false;
+
+    Type t = a->get_type();
+    std::vector<InSet::Chunk> chunks;
+    auto bucket = old->_by_type.find(t);
+    if (bucket != old->_by_type.end())
+        chunks = *bucket->second;
+
+    if (add)
+    {
+        if (chunks.empty() or InSet::Snapshot::CHUNK <= chunks.back()->size())
+            chunks.emplace_back(std::make_shared<const HandleSeq>(HandleSeq{a}));
+        else
+        {
+            HandleSeq hs(*chunks.back());
+            hs.emplace_back(a);
+            chunks.back() = std::make_shared<const HandleSeq>(std::move(hs));
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < chunks.size(); i++)
+        {
+            const HandleSeq& cur(*chunks[i]);
+            auto it = std::find(cur.begin(), cur.end(), a);
+            if (it == cur.end()) continue;
+            if (1 == cur.size())
+                chunks.erase(chunks.begin() + i);
+            else
+            {
+                HandleSeq hs(cur.begin(), it);
+                hs.insert(hs.end(), it + 1, cur.end());
+                chunks[i] = std::make_shared<const HandleSeq>(std::move(hs));
+            }
+            break;
+        }
+    }
+
+    InSet::Snapshot* neu = new InSet::Snapshot(*old);
+    if (chunks.empty())
+        neu->_by_type.erase(t);
+    else
+        neu->_by_type[t] =
+            std::make_shared<const std::vector<InSet::Chunk>>(std::move(chunks));
+
+    _incoming_set->_snap.store(neu);
+    epoch_manager().retire(old);
+    return true;
+}
+
+/// Unlink the read-only copy of the incoming set, if any, and hand
+/// it to the epoch manager. The caller must hold _mtx. Returns true
+/// if there was a copy; the caller should then call reclaim(), after
+/// releasing the lock.
+bool Atom::drop_snapshot()
+{
+    const InSet::Snapshot* old = _incoming_set->_snap.exchange(nullptr);
+    if (nullptr == old) return false;
+    epoch_manager().retire(old);
+    return true;
+}
+
+void Atom::reclaim()
+{
+    epoch_manager().reclaim();
 }
 
 /// Add an atom to the incoming set.
 void Atom::insert_atom(const Handle& a)
 {
     if (nullptr == _incoming_set) return;
-    std::lock_guard<std::mutex> lck (_mtx);
+    std::unique_lock<std::mutex> lck (_mtx);
 
     Type at = a->get_type();
     auto bucket = _incoming_set->_iset.find(at);
@@ -325,25 +585,35 @@ void Atom::insert_atom(const Handle& a)
                    std::make_pair(at, WincomingSet()));
         bucket = pr.first;
     }
-    bucket->second.insert(a);
+    bool retired = false;
+    if (bucket->second.insert(a).second)
+        retired = update_snapshot(a, true);
 
 #ifdef INCOMING_SET_SIGNALS
     _incoming_set->_addAtomSignal(shared_from_this(), a);
 #endif /* INCOMING_SET_SIGNALS */
+
+    lck.unlock();
+    if (retired) reclaim();
 }
 
 /// Remove an atom from the incoming set.
 void Atom::remove_atom(const Handle& a)
 {
     if (nullptr == _incoming_set) return;
-    std::lock_guard<std::mutex> lck (_mtx);
+    std::unique_lock<std::mutex> lck (_mtx);
 #ifdef INCOMING_SET_SIGNALS
     _incoming_set->_removeAtomSignal(shared_from_this(), a);
 #endif /* INCOMING_SET_SIGNALS */
     Type at = a->get_type();
     auto bucket = _incoming_set->_iset.find(at);
-    if (bucket != _incoming_set->_iset.end())
-        bucket->second.erase(a);
+    bool retired = false;
+    if (bucket != _incoming_set->_iset.end() and
+        0 < bucket->second.erase(a))
+        retired = update_snapshot(a, false);
+
+    lck.unlock();
+    if (retired) reclaim();
 }
 
 /// Remove old, and add new, atomically, so that every user
@@ -352,7 +622,10 @@ void Atom::remove_atom(const Handle& a)
 void Atom::swap_atom(const Handle& old, const Handle& neu)
 {
     if (nullptr == _incoming_set) return;
-    std::lock_guard<std::mutex> lck (_mtx);
+    std::unique_lock<std::mutex> lck (_mtx);
+    // Both changes must show up in one copy; just drop it, and let
+    // the next reader make a fresh one.
+    bool retired = drop_snapshot();
 
 #ifdef INCOMING_SET_SIGNALS
     _incoming_set->_removeAtomSignal(shared_from_this(), old);
@@ -374,6 +647,9 @@ void Atom::swap_atom(const Handle& old, const Handle& neu)
 #ifdef INCOMING_SET_SIGNALS
     _incoming_set->_addAtomSignal(shared_from_this(), neu);
 #endif /* INCOMING_SET_SIGNALS */
+
+    lck.unlock();
+    if (retired) reclaim();
 }
 
 void Atom::install() {}
@@ -27,14 +27,19 @@
 #ifndef _OPENCOG_ATOM_H
 #define _OPENCOG_ATOM_H
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include <opencog/util/empty_string.h>
 #include <opencog/util/sigslot.h>
+#include <opencog/atoms/base/Epoch.h>
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/value/Value.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
@@ -81,6 +86,11 @@ class AtomTable;
 //! arity of Links, represented as size_t to match outcoming set limit
 typedef std::size_t Arity;
 
+//! Small integer id of an atom, unique within its AtomTable. Only
+//! handed out by tables that keep an AtomIdIndex.
+typedef uint32_t AtomId;
+static const AtomId INVALID_ATOM_ID = UINT32_MAX;
+
 //! We use a std:vector instead of std::set for IncomingSet, because
 //! virtually all access will be either insert, or iterate, so we get
 //! O(1) performance. Note that sometimes incoming sets can be huge,
@@ -106,6 +116,7 @@ class Atom
     friend class Link;            // Needs to call install_atom()
     friend class StateLink;       // Needs to call swap_atom()
     friend class SQLAtomStorage;  // Needs to call getAtomTable()
+    friend class ValueColumn;     // Needs the atom id
     friend class ProtocolBufferSerializer; // Needs to de/ser-ialize an Atom
 
 protected:
@@ -119,14 +130,32 @@ protected:
     // Place this first, so that is shares a word with Type.
     mutable char _flags;
 
+    /// The id of the atom in its AtomTable, if the table hands out ids
+    /// (see AtomTable::enableAtomIds()). Placed here, it fits into the
+    /// padding in front of _content_hash, and so costs no memory.
+    AtomId _atom_id;
+
     /// Merkle-tree hash of the atom contents. Generically useful
     /// for indexing and comparison operations.
     mutable ContentHash _content_hash;
 
     AtomSpace *_atom_space;
 
-    /// All of the values on the atom, including the TV.
-    mutable std::map<const Handle, ValuePtr> _values;
+    /// All of the values on the atom. The truth value gets a slot of
+    /// its own, as nearly every atom has one; the other values go into
+    /// a short vector, searched in order, as most atoms have only one
+    /// or two keys. The slots are never changed in place: writers hold
+    /// _mtx, install a changed copy, and retire the old one to the
+    /// epoch manager, so that readers need no lock. Null if the atom
+    /// has no values at all.
+    struct ValueSlots
+    {
+        ValuePtr _tv;
+        std::vector<std::pair<Handle, ValuePtr>> _kvs;
+
+        ValuePtr find(const Handle& key, bool is_tv) const;
+    };
+    std::atomic<const ValueSlots*> _values;
 
     // Lock, used to serialize changes.
     // This costs 40 bytes per atom.  Tried using a single, global lock,
@@ -144,8 +173,10 @@ protected:
     Atom(Type t)
       : Value(t),
         _flags(0),
+        _atom_id(INVALID_ATOM_ID),
         _content_hash(Handle::INVALID_HASH),
-        _atom_space(nullptr)
+        _atom_space(nullptr),
+        _values(nullptr)
     {}
 
     Atom& operator=(const Atom& other) // copy assignment operator
@@ -181,6 +212,33 @@ protected:
         // buckets (I tried).
         std::map<Type, WincomingSet> _iset;
 
+        // A read-only copy of _iset, so that it can be walked without
+        // the atom lock, and without touching any reference counts.
+        // It is built on the first lock-free read. From then on, every
+        // change makes a new copy, and retires the old one to the epoch
+        // manager, which frees it once the readers are done with it.
+        // The copies are persistent: the links of each type are kept
+        // in chunks, and a new copy shares all but the one changed
+        // chunk, and the one changed bucket, with the old one. Thus, a
+        // change costs a few reference counts, and not one per link.
+        //
+        // The links are held by strong pointers. They leave the copy
+        // when they leave the incoming set, i.e. when they are taken
+        // out of the atomspace, and so the cycle that this forms with
+        // their outgoing sets does not outlast them. A link that left
+        // stays alive until the retired copies that hold it are freed.
+        typedef std::shared_ptr<const HandleSeq> Chunk;
+        typedef std::shared_ptr<const std::vector<Chunk>> Bucket;
+        struct Snapshot
+        {
+            static const size_t CHUNK = 64;
+            std::map<Type, Bucket> _by_type;
+        };
+        std::atomic<const Snapshot*> _snap;
+
+        InSet(void) : _snap(nullptr) {}
+        ~InSet() { delete _snap.load(); }
+
 #ifdef INCOMING_SET_SIGNALS
         // Some people want to know if the incoming set has changed...
         // However, these make the atom quite fat, so this is disabled
@@ -195,6 +253,20 @@ protected:
     void keep_incoming_set();
     void drop_incoming_set();
 
+    // Lock-free incoming-set reads. The caller of incoming_snapshot()
+    // must be inside an active EpochGuard; the callers of
+    // update_snapshot() and drop_snapshot() must hold _mtx, and then
+    // call reclaim() once they let go of it, if these return true.
+    const InSet::Snapshot* incoming_snapshot() const;
+    bool update_snapshot(const Handle&, bool add);
+    bool drop_snapshot();
+    static void reclaim();
+
+    // Set or (if null) remove the value at the key, bypassing any value
+    // column. The caller must hold _mtx; if this returns true, it must
+    // call reclaim() once it lets go of it.
+    bool put_value(const Handle& key, const ValuePtr& value);
+
     // Insert and remove links from the incoming set.
     void insert_atom(const Handle&);
     void remove_atom(const Handle&);
@@ -297,10 +369,7 @@ public:
     void copyValues(const Handle&);
 
     /// Return true if the set of values on this atom isn't empty.
-    bool haveValues() const {
-        // I think its safe to call empty() without holding a lock...!?
-        return not _values.empty();
-    }
+    bool haveValues() const;
 
     /// Print all of the key-value pairs.
     std::string valuesToString() const;
@@ -349,15 +418,109 @@ public:
     template<class T>
     inline bool foreach_incoming(bool (T::*cb)(const Handle&), T *data) const
     {
-        // We make a copy of the set, so that we don't call the
-        // callback with locks held.
-        IncomingSet vh(getIncomingSet());
+        return visit_incoming([&](const Handle& lp)->bool {
+            return (data->*cb)(lp);
+        });
+    }
+
+    //! Call `cb(const Handle&)` on each link in the incoming set,
+    //! until it returns true; then stop, and return true. Otherwise
+    //! return false.
+    //!
+    //! This takes no locks, does not copy the set, and does not touch
+    //! the reference counts of the links; the callback sees the
+    //! incoming set as it was when the walk started, and so it may
+    //! freely change the incoming set, e.g. by adding or removing
+    //! links. The links that it is handed stay valid until it
+    //! returns, even if they are removed in some other thread.
+    template <typename Function>
+    bool visit_incoming(Function cb) const
+    {
+        if (nullptr == _incoming_set) return false;
 
-        for (const Handle& lp : vh)
-            if ((data->*cb)(lp)) return true;
+        EpochGuard guard;
+        if (not guard.active()) {
+            for (const Handle& h : getIncomingSet())
+                if (cb(h)) return true;
+            return false;
+        }
+
+        const InSet::Snapshot* snap = incoming_snapshot();
+        for (const auto& bucket : snap->_by_type)
+            for (const InSet::Chunk& chunk : *bucket.second)
+                for (const Handle& h : *chunk)
+                    if (cb(h)) return true;
         return false;
     }
 
+    //! Same as visit_incoming(), but only for links of the given type.
+    template <typename Function>
+    bool visit_incoming_by_type(Type type, Function cb) const
+    {
+        if (nullptr == _incoming_set) return false;
+
+        EpochGuard guard;
+        if (not guard.active()) {
+            for (const Handle& h : getIncomingSetByType(type))
+                if (cb(h)) return true;
+            return false;
+        }
+
+        const InSet::Snapshot* snap = incoming_snapshot();
+        const auto bucket = snap->_by_type.find(type);
+        if (bucket == snap->_by_type.cend()) return false;
+        for (const InSet::Chunk& chunk : *bucket->second)
+            for (const Handle& h : *chunk)
+                if (cb(h)) return true;
+        return false;
+    }
+
+    //! Same as visit_incoming(), but only for links of the given
+    //! type, or, if `subclass` is set, of any of its subtypes.
+    template <typename Function>
+    bool visit_incoming_by_type(Type type, bool subclass, Function cb) const
+    {
+        if (not subclass) return visit_incoming_by_type(type, cb);
+        return visit_incoming_if([type](Type t)->bool {
+            return nameserver().isA(t, type); }, cb);
+    }
+
+    //! Same as visit_incoming(), but only for links of the given types.
+    template <typename Function>
+    bool visit_incoming_by_type(const TypeSet& types, Function cb) const
+    {
+        return visit_incoming_if([&types](Type t)->bool {
+            return types.find(t) != types.end(); }, cb);
+    }
+
+private:
+    // Visit the links whose type passes `pred`. The types are tested
+    // once per bucket, and not once per link.
+    template <typename TypePred, typename Function>
+    bool visit_incoming_if(TypePred pred, Function cb) const
+    {
+        if (nullptr == _incoming_set) return false;
+
+        EpochGuard guard;
+        if (not guard.active()) {
+            for (const Handle& h : getIncomingSet())
+                if (pred(h->get_type()) and cb(h)) return true;
+            return false;
+        }
+
+        const InSet::Snapshot* snap = incoming_snapshot();
+        for (const auto& bucket : snap->_by_type)
+        {
+            if (not pred(bucket.first)) continue;
+            for (const InSet::Chunk& chunk : *bucket.second)
+                for (const Handle& h : *chunk)
+                    if (cb(h)) return true;
+        }
+        return false;
+    }
+
+public:
+
     /**
      * Return all atoms of type `type` that contain this atom.
      * That is, return all atoms that contain this atom, and are
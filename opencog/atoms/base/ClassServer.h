@@ -99,6 +99,16 @@ public:
     void addValidator(Type, Validator*);
     Validator* getValidator(Type) const;
 
+    /**
+     * Return true if atoms of this type are plain Nodes or Links,
+     * that is, there is neither a factory nor a validator for them.
+     * Such atoms can be looked up without being constructed first.
+     */
+    bool isPlain(Type t) const
+    {
+        return nullptr == getFactory(t) and nullptr == getValidator(t);
+    }
+
     /**
      * Convert the indicated Atom into a C++ instance of the
      * same type.
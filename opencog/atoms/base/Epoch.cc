@@ -0,0 +1,242 @@
+/*
+ * opencog/atoms/base/Epoch.cc
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#include <opencog/atoms/base/Epoch.h>
+
+using namespace opencog;
+
+namespace {
+
+// Set once the retire list of this thread has been destroyed; plain
+// bool, so that it outlives the list itself.
+thread_local bool retire_list_gone = false;
+
+// Move the retired items that no reader can be using from `from` to
+// `done`.
+template<typename V>
+void split(V& from, uint64_t oldest, V& done)
+{
+    auto keep = std::partition(from.begin(), from.end(),
+        [&](const typename V::value_type& r)->bool
+            { return oldest <= r.epoch; });
+
+    std::move(keep, from.end(), std::back_inserter(done));
+    from.erase(keep, from.end());
+}
+
+}
+
+EpochManager::EpochManager()
+{
+    for (Slot& s : _slots)
+    {
+        s.epoch = 0;
+        s.in_use = false;
+    }
+    _nslots = 0;
+    // Zero is reserved, to mean "not reading".
+    _global = 1;
+    _norphans = 0;
+}
+
+EpochManager::~EpochManager()
+{
+    // This runs at program exit. The deleters might destroy atoms,
+    // which would then try to retire things into this half-destroyed
+    // manager; so whatever is left is simply left to the OS.
+}
+
+int EpochManager::acquire_slot()
+{
+    for (size_t i = 0; i < MAX_READERS; i++)
+    {
+        bool expect = false;
+        if (not _slots[i].in_use.compare_exchange_strong(expect, true))
+            continue;
+
+        // Publish the slot before its first use, so that reclaim()
+        // cannot miss a reader in it.
+        size_t n = _nslots.load();
+        while (n <= i and not _nslots.compare_exchange_weak(n, i + 1)) {}
+        return (int) i;
+    }
+    return -1;
+}
+
+void EpochManager::release_slot(int slot)
+{
+    _slots[slot].epoch = 0;
+    _slots[slot].in_use = false;
+}
+
+uint64_t EpochManager::oldest_reader() const
+{
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    size_t n = _nslots.load();
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t e = _slots[i].epoch.load();
+        if (0 < e and e < oldest) oldest = e;
+    }
+    return oldest;
+}
+
+// ==============================================================
+
+EpochManager::RetireList* EpochManager::retire_list()
+{
+    if (retire_list_gone) return nullptr;
+    thread_local RetireList list;
+    return &list;
+}
+
+EpochManager::RetireList::~RetireList()
+{
+    // Free what can be freed now. The deleters may retire more data,
+    // which then lands in this list again; it is handed off below.
+    EpochManager& mgr = epoch_manager();
+    if (not items.empty()) mgr.flush();
+    retire_list_gone = true;
+    if (not items.empty()) mgr.orphan(items);
+}
+
+void EpochManager::orphan(std::vector<Retired>& items)
+{
+    std::lock_guard<std::mutex> lck(_orphan_mtx);
+    _orphans.insert(_orphans.end(), items.begin(), items.end());
+    _norphans = _orphans.size();
+    items.clear();
+}
+
+void EpochManager::retire(const void* ptr, Deleter deleter)
+{
+    // The epoch only moves on in flush(). Readers that might still
+    // hold on to the data entered before it was unlinked, so their
+    // epoch is no later than this one.
+    Retired r{_global.load(), deleter, ptr};
+
+    RetireList* rl = retire_list();
+    if (rl)
+    {
+        rl->items.push_back(r);
+        return;
+    }
+
+    // This thread is exiting.
+    std::vector<Retired> one(1, r);
+    orphan(one);
+}
+
+void EpochManager::reclaim()
+{
+    RetireList* rl = retire_list();
+    if ((nullptr == rl or rl->items.size() < rl->next_reclaim) and
+        _norphans < RECLAIM_BATCH)
+        return;
+    flush();
+}
+
+void EpochManager::flush()
+{
+    // Readers that enter from now on get a later epoch than anything
+    // retired so far, and thus cannot hold on to it.
+    _global.fetch_add(1);
+    uint64_t oldest = oldest_reader();
+
+    std::vector<Retired> done;
+    RetireList* rl = retire_list();
+    if (rl)
+    {
+        split(rl->items, oldest, done);
+        rl->next_reclaim = rl->items.size() + RECLAIM_BATCH;
+    }
+
+    if (0 < _norphans)
+    {
+        std::unique_lock<std::mutex> lck(_orphan_mtx, std::try_to_lock);
+        if (lck.owns_lock())
+        {
+            split(_orphans, oldest, done);
+            _norphans = _orphans.size();
+        }
+    }
+
+    // The deleters may drop the last reference to atoms, and so run
+    // arbitrary destructors, which may retire more data; so they run
+    // only after the lists have been brought up to date.
+    for (const Retired& r : done)
+        r.deleter(r.ptr);
+}
+
+size_t EpochManager::pending() const
+{
+    RetireList* rl = retire_list();
+    return (rl ? rl->items.size() : 0) + _norphans;
+}
+
+EpochManager& opencog::epoch_manager()
+{
+    static EpochManager mgr;
+    return mgr;
+}
+
+// ==============================================================
+
+namespace {
+
+/// The reader slot of this thread, handed back when the thread exits.
+struct ReaderSlot
+{
+    int slot = -2;  // -2 is "not asked for yet", -1 is "none free".
+    unsigned depth = 0;
+    ~ReaderSlot()
+    {
+        if (0 <= slot) epoch_manager().release_slot(slot);
+    }
+};
+
+thread_local ReaderSlot reader;
+
+}
+
+EpochGuard::EpochGuard()
+{
+    if (-2 == reader.slot)
+        reader.slot = epoch_manager().acquire_slot();
+
+    _slot = reader.slot;
+    if (_slot < 0) return;
+    if (0 == reader.depth++)
+        epoch_manager().enter(_slot);
+}
+
+EpochGuard::~EpochGuard()
+{
+    // Leaving is a single store. Readers do not reclaim; writers do,
+    // in batches, and threads do when they exit.
+    if (_slot < 0) return;
+    if (0 < --reader.depth) return;
+    epoch_manager().leave(_slot);
+}
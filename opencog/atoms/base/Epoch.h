@@ -0,0 +1,173 @@
+/*
+ * opencog/atoms/base/Epoch.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_EPOCH_H
+#define _OPENCOG_EPOCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Epoch-based reclamation, for data that is read without locks.
+ *
+ * Readers wrap each access in an EpochGuard. Writers first unlink the
+ * old data, so that new readers can no longer find it, and then hand
+ * it to retire(). Retired data is freed by reclaim(), but only after
+ * every reader that might still be looking at it has left its guard.
+ *
+ * There is a fixed number of reader slots. A thread holds on to a slot
+ * from its first guard until it exits. If all of the slots are taken,
+ * the guard is inactive, and the reader has to fall back to locking.
+ *
+ * Each thread keeps its own list of retired data, so that writers to
+ * different atoms do not contend; reclaim() only does real work once
+ * the list has grown to RECLAIM_BATCH items. Whatever is left when a
+ * thread exits goes to a shared list, freed by the next thread to
+ * reclaim. The lists are per thread, not per manager: there should be
+ * only the one manager, from epoch_manager().
+ */
+class EpochManager
+{
+    public:
+        static const size_t MAX_READERS = 256;
+
+        /// Number of items a thread retires before it reclaims.
+        static const size_t RECLAIM_BATCH = 64;
+
+        typedef void (*Deleter)(const void*);
+
+    private:
+        struct alignas(64) Slot
+        {
+            // The global epoch when the reader entered; zero if the
+            // reader is not reading right now.
+            std::atomic<uint64_t> epoch;
+            std::atomic_bool in_use;
+        };
+        Slot _slots[MAX_READERS];
+
+        // One past the highest slot ever handed out; the slots above
+        // it never need to be looked at.
+        std::atomic_size_t _nslots;
+        std::atomic<uint64_t> _global;
+
+        struct Retired
+        {
+            uint64_t epoch;
+            Deleter deleter;
+            const void* ptr;
+        };
+
+        // The retired data of one thread.
+        struct RetireList
+        {
+            std::vector<Retired> items;
+            // Reclaim once there are this many; what could not be
+            // freed last time does not count towards the batch.
+            size_t next_reclaim = RECLAIM_BATCH;
+            ~RetireList();
+        };
+        static RetireList* retire_list();
+
+        // Retired data left behind by threads that exited.
+        std::mutex _orphan_mtx;
+        std::vector<Retired> _orphans;
+        std::atomic_size_t _norphans;
+
+        uint64_t oldest_reader() const;
+        void orphan(std::vector<Retired>&);
+
+    public:
+        EpochManager();
+        ~EpochManager();
+
+        /// Get a free reader slot, or -1 if there are none left.
+        int acquire_slot();
+        void release_slot(int);
+
+        // The store must be sequentially consistent, so that it is
+        // ordered before the reader's loads of the data it guards.
+        void enter(int slot)
+        {
+            _slots[slot].epoch.store(_global.load());
+        }
+        void leave(int slot)
+        {
+            _slots[slot].epoch.store(0, std::memory_order_release);
+        }
+
+        /// Call `deleter(ptr)` once no reader can be using the data any
+        /// more. The data must already be unreachable for new readers.
+        void retire(const void* ptr, Deleter deleter);
+
+        template<typename T>
+        void retire(const T* ptr)
+        {
+            retire(ptr, [](const void* p) { delete static_cast<const T*>(p); });
+        }
+
+        /// Free the data retired by this thread that no reader can be
+        /// using any more; but only once there is a batch of it, so
+        /// this is cheap to call after every retire(). Never blocks.
+        void reclaim();
+
+        /// As reclaim(), but whatever the size of the batch.
+        void flush();
+
+        /// Number of items retired by this thread, or left behind by
+        /// threads that exited, that are not yet freed.
+        size_t pending() const;
+};
+
+EpochManager& epoch_manager();
+
+/**
+ * Marks the current thread as reading lock-free data, for as long as
+ * the guard is in scope. Guards can be nested.
+ */
+class EpochGuard
+{
+    private:
+        int _slot;
+
+    public:
+        EpochGuard();
+        ~EpochGuard();
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+
+        /// False if no reader slot was available; the caller must
+        /// then use a locking path.
+        bool active() const { return 0 <= _slot; }
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_EPOCH_H
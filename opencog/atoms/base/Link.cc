@@ -28,6 +28,7 @@
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/base/hash.h>
 #include <opencog/atomspace/AtomTable.h>
 
 #include "Link.h"
@@ -169,9 +170,29 @@ bool Link::operator<(const Atom& other) const
 /// chains the hash values of the child atoms, as well.
 ContentHash Link::compute_hash() const
 {
+	return content_hash(get_type(), _outgoing);
+}
+
+ContentHash Link::content_hash(Type t, const HandleSeq& oset)
+{
+#ifdef FAST_CONTENT_HASH
+	// Two outgoing hashes are folded in with a single multiply;
+	// the two are xor'ed with different things, so that swapping
+	// them changes the result. The arity goes into the final mix,
+	// so that sequences of different lengths are kept apart.
+	ContentHash hsh = wy_mix(t ^ WY_P0, WY_P1);
+	size_t sz = oset.size();
+	size_t i = 0;
+	for (; i + 2 <= sz; i += 2)
+		hsh = wy_mix(oset[i]->get_hash() ^ WY_P1,
+		             oset[i+1]->get_hash() ^ hsh); // recursive!
+	if (i < sz)
+		hsh = wy_mix(oset[i]->get_hash() ^ WY_P2, hsh ^ WY_P1);
+	hsh = wy_mix(hsh ^ WY_P3, sz ^ WY_P0);
+#else
 	// 1<<44 - 377 is prime
-	ContentHash hsh = ((1UL<<44) - 377) * get_type();
-	for (const Handle& h: _outgoing)
+	ContentHash hsh = ((1UL<<44) - 377) * t;
+	for (const Handle& h: oset)
 	{
 		hsh += (hsh <<5) ^ (353 * h->get_hash()); // recursive!
 
@@ -182,6 +203,7 @@ ContentHash Link::compute_hash() const
 		hsh *= 0xc4ceb9fe1a85ec53L;
 		hsh ^= hsh >> 33;
 	}
+#endif
 
 	// Links will always have the MSB set.
 	ContentHash mask = ((ContentHash) 1UL) << (8*sizeof(ContentHash) - 1);
@@ -125,6 +125,13 @@ public:
         return _outgoing.size();
     }
 
+    /**
+     * Return the content hash that a plain Link of the given type and
+     * outgoing set would have. This allows the AtomTable to be
+     * searched without constructing a Link first.
+     */
+    static ContentHash content_hash(Type, const HandleSeq&);
+
     /**
      * Returns a const reference to the array containing this
      * atom's outgoing set.
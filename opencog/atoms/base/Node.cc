@@ -22,6 +22,7 @@
  */
 
 #include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/hash.h>
 
 #include "Node.h"
 
@@ -90,10 +91,21 @@ bool Node::operator<(const Atom& other) const
 
 ContentHash Node::compute_hash() const
 {
-	ContentHash hsh = std::hash<std::string>()(get_name());
+	return content_hash(get_type(), get_name());
+}
+
+ContentHash Node::content_hash(Type t, const std::string& name)
+{
+#ifdef FAST_CONTENT_HASH
+	// The type is the seed, so that nodes of different types,
+	// having the same name, get unrelated hashes.
+	ContentHash hsh = wy_hash(name.data(), name.size(), t);
+#else
+	ContentHash hsh = std::hash<std::string>()(name);
 
 	// 1<<43 - 369 is a prime number.
-	hsh += (hsh<<5) + ((1UL<<43)-369) * get_type();
+	hsh += (hsh<<5) + ((1UL<<43)-369) * t;
+#endif
 
 	// Nodes will never have the MSB set.
 	ContentHash mask = ~(((ContentHash) 1UL) << (8*sizeof(ContentHash) - 1));
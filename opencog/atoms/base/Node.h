@@ -77,6 +77,13 @@ public:
 
     virtual size_t size() const { return 1; }
 
+    /**
+     * Return the content hash that a plain Node of the given type and
+     * name would have. This allows the AtomTable to be searched
+     * without constructing a Node first.
+     */
+    static ContentHash content_hash(Type, const std::string&);
+
     /**
      * Returns a string representation of the node.
      *
@@ -1,6 +1,9 @@
 #ifndef _OPENCOG_HASH_H
 #define _OPENCOG_HASH_H
 
+#include <cstdint>
+#include <cstring>
+
 #include <opencog/atoms/base/Handle.h>
 
 namespace opencog {
@@ -61,6 +64,106 @@ typename std::enable_if<sizeof(ContentHash) < sizeof(T), ContentHash>::type fnv1
 	return hval;
 }
 
+// ---------------------------------------------------------------
+// wyhash-style hashing, used for the atom content hash when the
+// FAST_CONTENT_HASH build option is on. The mixer multiplies two
+// 64-bit words into 128 bits, and folds the halves together; this
+// is both cheaper and better at spreading the bits than a chain of
+// shifts and xors. See https://github.com/wangyi-fudan/wyhash
+
+const uint64_t WY_P0 = 0xa0761d6478bd642full;
+const uint64_t WY_P1 = 0xe7037ed1a0b428dbull;
+const uint64_t WY_P2 = 0x8ebc6af09c88c6e3ull;
+const uint64_t WY_P3 = 0x589965cc75374cc3ull;
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = (__uint128_t) a * b;
+	return (uint64_t) r ^ (uint64_t) (r >> 64);
+#else
+	// Schoolbook 64x64 -> 128 multiply, for compilers without int128.
+	uint64_t ha = a >> 32, la = (uint32_t) a;
+	uint64_t hb = b >> 32, lb = (uint32_t) b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t = rl + (rm0 << 32);
+	uint64_t c = t < rl;
+	uint64_t lo = t + (rm1 << 32);
+	c += lo < t;
+	uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+	return lo ^ hi;
+#endif
+}
+
+static inline uint64_t wy_read8(const uint8_t* p)
+{
+	uint64_t v; memcpy(&v, p, 8); return v;
+}
+
+static inline uint64_t wy_read4(const uint8_t* p)
+{
+	uint32_t v; memcpy(&v, p, 4); return v;
+}
+
+// Reads 1 to 3 bytes.
+static inline uint64_t wy_read3(const uint8_t* p, size_t k)
+{
+	return (((uint64_t) p[0]) << 16) | (((uint64_t) p[k >> 1]) << 8) | p[k - 1];
+}
+
+/// Hash `len` bytes at `key`. Strings are read eight bytes at a time;
+/// long strings are run through three independent lanes, so that the
+/// multiplies can overlap in the CPU pipeline.
+static inline uint64_t wy_hash(const void* key, size_t len, uint64_t seed)
+{
+	const uint8_t* p = (const uint8_t*) key;
+	seed ^= wy_mix(seed ^ WY_P0, WY_P1);
+	uint64_t a, b;
+	if (len <= 16)
+	{
+		if (4 <= len)
+		{
+			a = (wy_read4(p) << 32) | wy_read4(p + ((len >> 3) << 2));
+			b = (wy_read4(p + len - 4) << 32) |
+			    wy_read4(p + len - 4 - ((len >> 3) << 2));
+		}
+		else if (0 < len)
+		{
+			a = wy_read3(p, len);
+			b = 0;
+		}
+		else
+			a = b = 0;
+	}
+	else
+	{
+		size_t i = len;
+		if (48 < i)
+		{
+			uint64_t see1 = seed, see2 = seed;
+			do
+			{
+				seed = wy_mix(wy_read8(p) ^ WY_P1, wy_read8(p + 8) ^ seed);
+				see1 = wy_mix(wy_read8(p + 16) ^ WY_P2, wy_read8(p + 24) ^ see1);
+				see2 = wy_mix(wy_read8(p + 32) ^ WY_P3, wy_read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			}
+			while (48 < i);
+			seed ^= see1 ^ see2;
+		}
+		while (16 < i)
+		{
+			seed = wy_mix(wy_read8(p) ^ WY_P1, wy_read8(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		a = wy_read8(p + i - 16);
+		b = wy_read8(p + i - 8);
+	}
+	return wy_mix(WY_P1 ^ len, wy_mix(a ^ WY_P1, b ^ seed));
+}
+
 } // namespace opencog
 
 #endif // _OPENCOG_HASH_H
@@ -39,7 +39,8 @@ UnorderedLink::UnorderedLink(const HandleSeq&& oset, Type t)
 
 	// Place into arbitrary, but deterministic order. We use
 	// content (hash) based less, to avoid variations due to
-	// address-space randomization.
+	// address-space randomization. The order thus changes with
+	// the content hash function; see FAST_CONTENT_HASH.
 	std::sort(_outgoing.begin(), _outgoing.end(),
 		content_based_handle_less());
 }
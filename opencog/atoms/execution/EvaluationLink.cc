@@ -5,8 +5,6 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
-#include <thread>
-
 #include <opencog/atoms/atom_types/atom_types.h>
 #include <opencog/atoms/core/DefineLink.h>
 #include <opencog/atoms/core/LambdaLink.h>
@@ -24,6 +22,7 @@
 
 #include <opencog/atomspace/AtomSpace.h>
 
+#include "Executor.h"
 #include "Force.h"
 #include "EvaluationLink.h"
 
@@ -402,21 +401,6 @@ static void thread_eval(AtomSpace* as,
 	}
 }
 
-static void thread_eval_tv(AtomSpace* as,
-                           const Handle& evelnk, AtomSpace* scratch,
-                           bool silent, TruthValuePtr* tv,
-                           std::exception_ptr* returned_ex)
-{
-	try
-	{
-		*tv = EvaluationLink::do_eval_scratch(as, evelnk, scratch, silent);
-	}
-	catch (const std::exception& ex)
-	{
-		*returned_ex = std::current_exception();
-	}
-}
-
 static TruthValuePtr bool_to_tv(bool truf)
 {
 	if (truf) return TruthValue::TRUE_TV();
@@ -587,20 +571,18 @@ static bool crispy_maybe(AtomSpace* as,
 		size_t arity = oset.size();
 		std::vector<TruthValuePtr> tvp(arity);
 
-		// Create a collection of joinable threads.
-		std::vector<std::thread> thread_set;
-		std::exception_ptr ex;
+		// Run the children on the shared executor, and wait for all
+		// of them. If any of them threw, the wait rethrows.
+		TaskGroup group;
 		for (size_t i=0; i<arity; i++)
 		{
-			thread_set.push_back(std::thread(&thread_eval_tv,
-				as, oset[i], scratch, silent, &tvp[i], &ex));
+			const Handle& h = oset[i];
+			TruthValuePtr* tv = &tvp[i];
+			group.run([as, h, scratch, silent, tv]() {
+				*tv = EvaluationLink::do_eval_scratch(as, h, scratch, silent);
+			});
 		}
-
-		// Wait for it all to come together.
-		for (std::thread& t : thread_set) t.join();
-
-		// Were there any exceptions? If so, rethrow.
-		if (ex) std::rethrow_exception(ex);
+		group.wait();
 
 		// Return the logical-AND of the returned truth values
 		for (const TruthValuePtr& tv: tvp)
@@ -612,11 +594,16 @@ static bool crispy_maybe(AtomSpace* as,
 	}
 	else if (PARALLEL_LINK == t)
 	{
-		// Create and detach threads; return immediately.
+		// Queue the children, and return immediately. These are not
+		// joined, and may never finish, so they go onto the detached
+		// executor, and not the shared one, where they would hold up
+		// its workers. The detached executor has a bounded number of
+		// threads; children beyond that wait for one to come free.
 		for (const Handle& h : evelnk->getOutgoingSet())
 		{
-			std::thread thr(&thread_eval, as, h, scratch, silent);
-			thr.detach();
+			detached_executor().submit([as, h, scratch, silent]() {
+				thread_eval(as, h, scratch, silent);
+			});
 		}
 		return true;
 	}
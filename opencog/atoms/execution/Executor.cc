@@ -0,0 +1,353 @@
+/*
+ * opencog/atoms/execution/Executor.cc
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/oc_omp.h>
+
+#include "Executor.h"
+
+using namespace opencog;
+
+// How often the monitor looks for stalled workers.
+static const std::chrono::milliseconds MONITOR_TICK(20);
+
+// How long a worker beyond the core size may stay idle.
+static const std::chrono::seconds IDLE_TIMEOUT(2);
+
+namespace {
+
+// The executor and the slot of the current thread, if it is a worker.
+thread_local Executor* this_exec = nullptr;
+thread_local int this_slot = -1;
+
+}
+
+Executor::Executor(size_t core, size_t max, bool eager)
+{
+	if (0 == core) core = std::max((size_t) 1, (size_t) opencog::num_threads());
+	_core = std::min(core, MAX_WORKERS);
+	_max = std::min(std::max(max, _core), MAX_WORKERS);
+	_eager = eager;
+	_stop = false;
+	_queued = 0;
+	_started = 0;
+	_idle = 0;
+	_nworkers = 0;
+	_top = 0;
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	while (_nworkers < _core) start_worker();
+	_monitor = std::thread(&Executor::monitor, this);
+}
+
+Executor::~Executor()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stop = true;
+	}
+	_cv.notify_all();
+	_monitor_cv.notify_all();
+
+	_monitor.join();
+	for (Worker& w : _workers)
+		if (w.thr.joinable()) w.thr.join();
+}
+
+// Caller must hold _mtx.
+void Executor::start_worker(void)
+{
+	for (size_t slot = 0; slot < MAX_WORKERS; slot++)
+	{
+		Worker& w = _workers[slot];
+		if (w.live) continue;
+
+		// A worker that went idle may still be on its way out.
+		if (w.thr.joinable()) w.thr.join();
+		w.live = true;
+		_nworkers++;
+		if (_top <= slot) _top = slot + 1;
+		w.thr = std::thread(&Executor::work, this, slot);
+		return;
+	}
+}
+
+void Executor::set_size(size_t core, size_t max)
+{
+	if (0 == core) core = 1;
+	std::lock_guard<std::mutex> lck(_mtx);
+	_core = std::min(core, MAX_WORKERS);
+	_max = std::min(std::max(max, _core), MAX_WORKERS);
+	while (_nworkers < _core) start_worker();
+}
+
+// ==============================================================
+
+void Executor::wake(void)
+{
+	// A worker going to sleep first counts itself as idle, and then
+	// checks for queued tasks; we queue first, and then check for idle
+	// workers. So either it sees our task, or we see it. Taking the
+	// lock makes sure that it is either not yet checking, or already
+	// waiting.
+	if (_eager and _idle < _queued)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (_idle < _queued and _nworkers < _max and not _stop)
+			start_worker();
+	}
+	if (0 == _idle) return;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+	}
+	_cv.notify_one();
+}
+
+Executor::TaskPtr Executor::spawn(Function&& func)
+{
+	TaskPtr task(std::make_shared<Task>(std::move(func)));
+	if (this == this_exec)
+	{
+		Worker& w = _workers[this_slot];
+		std::lock_guard<std::mutex> lck(w.mtx);
+		w.tasks.push_back(task);
+		w.ntasks = w.tasks.size();
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lck(_shared_mtx);
+		_shared.push_back(task);
+	}
+	_queued++;
+	wake();
+	return task;
+}
+
+void Executor::submit(Function&& func)
+{
+	spawn(std::move(func));
+}
+
+void Executor::run(const TaskPtr& task)
+{
+	_started++;
+	try
+	{
+		task->func();
+	}
+	catch (const std::exception& ex)
+	{
+		logger().warn("Executor: task threw an exception:\n%s", ex.what());
+	}
+	catch (...)
+	{
+		logger().warn("Executor: task threw an exception");
+	}
+}
+
+// Pop one unclaimed task off the queue, discarding those that were
+// claimed already.
+bool Executor::pop(Worker& w, bool back, TaskPtr& task)
+{
+	std::lock_guard<std::mutex> lck(w.mtx);
+	while (not w.tasks.empty())
+	{
+		if (back)
+		{
+			task = std::move(w.tasks.back());
+			w.tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(w.tasks.front());
+			w.tasks.pop_front();
+		}
+		w.ntasks = w.tasks.size();
+		_queued--;
+		if (task->claim()) return true;
+	}
+	return false;
+}
+
+Executor::TaskPtr Executor::find_task(int slot)
+{
+	TaskPtr task;
+
+	// Our own newest task first; it is most likely to be in cache.
+	if (0 <= slot and pop(_workers[slot], true, task))
+		return task;
+
+	{
+		std::lock_guard<std::mutex> lck(_shared_mtx);
+		while (not _shared.empty())
+		{
+			task = std::move(_shared.front());
+			_shared.pop_front();
+			_queued--;
+			if (task->claim()) return task;
+		}
+	}
+
+	// Steal the oldest task of some other worker. Only the slots that
+	// ever had a worker are looked at, and only the queues that are
+	// not empty get locked.
+	size_t top = _top;
+	for (size_t i = 1; i <= top; i++)
+	{
+		size_t victim = (slot + i) % top;
+		if (victim == (size_t) slot) continue;
+		Worker& w = _workers[victim];
+		if (0 < w.ntasks and pop(w, false, task))
+			return task;
+	}
+	return nullptr;
+}
+
+void Executor::work(size_t slot)
+{
+	this_exec = this;
+	this_slot = slot;
+
+	while (true)
+	{
+		TaskPtr task;
+		if (0 < _queued) task = find_task(slot);
+		if (task)
+		{
+			run(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lck(_mtx);
+		_idle++;
+		bool woke = _cv.wait_for(lck, IDLE_TIMEOUT,
+			[&]() { return _stop or 0 < _queued; });
+		_idle--;
+		if (_stop) break;
+
+		if (not woke and _core < _nworkers)
+		{
+			_workers[slot].live = false;
+			_nworkers--;
+			return;
+		}
+	}
+}
+
+void Executor::monitor(void)
+{
+	size_t last_started = _started;
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (not _stop)
+	{
+		_monitor_cv.wait_for(lck, MONITOR_TICK);
+		if (_stop) break;
+
+		// Tasks are waiting, but no worker is free, and none of them
+		// got to start a task in a whole tick: they are all stuck in
+		// long-running tasks. Add a worker.
+		size_t started = _started;
+		if (0 < _queued and 0 == _idle and started == last_started and
+		    _nworkers < _max)
+			start_worker();
+		last_started = started;
+	}
+}
+
+Executor& opencog::executor()
+{
+	static Executor* exec = new Executor();
+	return *exec;
+}
+
+Executor& opencog::detached_executor()
+{
+	static Executor* exec = new Executor(1, Executor::MAX_WORKERS, true);
+	return *exec;
+}
+
+// ==============================================================
+
+TaskGroup::TaskGroup(Executor& ex) :
+	_exec(ex), _pending(0)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+	// The tasks refer to this group; they must be done before it goes.
+	try { wait(); }
+	catch (...) {}
+}
+
+void TaskGroup::finish(std::exception_ptr ex)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (ex and not _ex) _ex = ex;
+	if (0 == --_pending) _cv.notify_all();
+}
+
+void TaskGroup::call(const Executor::Function& func)
+{
+	try
+	{
+		func();
+	}
+	catch (...)
+	{
+		finish(std::current_exception());
+		return;
+	}
+	finish(nullptr);
+}
+
+void TaskGroup::run(Executor::Function&& func)
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_pending++;
+	}
+	// Bind moves the function in; whatever it captured is not copied.
+	_tasks.emplace_back(_exec.spawn(
+		std::bind(&TaskGroup::call, this, std::move(func))));
+}
+
+void TaskGroup::wait(void)
+{
+	// Run whatever no worker got to yet, newest first, as the
+	// workers take the oldest.
+	for (auto it = _tasks.rbegin(); it != _tasks.rend(); it++)
+		if ((*it)->claim()) _exec.run(*it);
+
+	std::unique_lock<std::mutex> lck(_mtx);
+	_cv.wait(lck, [&]() { return 0 == _pending; });
+	_tasks.clear();
+
+	if (_ex)
+	{
+		std::exception_ptr ex(_ex);
+		_ex = nullptr;
+		std::rethrow_exception(ex);
+	}
+}
@@ -0,0 +1,218 @@
+/*
+ * opencog/atoms/execution/Executor.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_EXECUTOR_H
+#define _OPENCOG_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A work-stealing pool of threads, on which ThreadJoinLink runs its
+ * children, instead of starting a new thread for each child, every
+ * time. ParallelLink children are not joined, and may well run
+ * forever; they run on a pool of their own, detached_executor(), so
+ * as not to use up the workers of this one.
+ *
+ * Each worker keeps its own queue of tasks. Tasks submitted by a
+ * worker go onto its own queue, and are run newest-first; idle
+ * workers steal the oldest tasks from the queues of the others.
+ * Tasks submitted from any other thread go onto a shared queue.
+ *
+ * Atomese tasks may block, e.g. in a SleepLink, or loop forever.
+ * So that such tasks cannot starve the others, a monitor thread
+ * checks, every few milliseconds, whether tasks are waiting while
+ * every worker is busy and none has started a task since the last
+ * check. If so, it starts another worker, up to the maximum size.
+ * An eager executor does not wait for the monitor: it starts another
+ * worker whenever a task is queued and no worker is free to take it.
+ * Workers beyond the core size exit after being idle for a while.
+ *
+ * A task runs on a thread that has run other tasks before it, and
+ * sees whatever thread_local state those left behind: e.g. the guile
+ * evaluators and the current scheme atomspace, and the python
+ * execution context. Atomese is not affected, as the evaluators are
+ * looked up, and their atomspace set, for each call; but tasks must
+ * not count on starting out with fresh thread_local state.
+ */
+class Executor
+{
+	public:
+		static const size_t MAX_WORKERS = 256;
+
+		typedef std::function<void()> Function;
+
+		/// A task is run exactly once, by whoever claims it first:
+		/// either a worker, or a TaskGroup waiting for it.
+		struct Task
+		{
+			Function func;
+			std::atomic_bool claimed;
+
+			Task(Function&& f) : func(std::move(f)), claimed(false) {}
+			bool claim(void)
+			{
+				bool expect = false;
+				return claimed.compare_exchange_strong(expect, true);
+			}
+		};
+		typedef std::shared_ptr<Task> TaskPtr;
+
+	private:
+		struct alignas(64) Worker
+		{
+			std::mutex mtx;
+			std::deque<TaskPtr> tasks;
+			std::thread thr;
+			bool live = false;   // Guarded by Executor::_mtx
+
+			// The size of the queue, so that thieves can pass by
+			// empty queues without taking the lock.
+			std::atomic_size_t ntasks{0};
+		};
+		Worker _workers[MAX_WORKERS];
+
+		// One past the highest slot a worker was ever started in;
+		// the slots above it never need to be looked at.
+		std::atomic_size_t _top;
+
+		std::mutex _shared_mtx;
+		std::deque<TaskPtr> _shared;
+
+		// Guards the worker slots, the sizes and _stop. Idle workers
+		// sleep on _cv.
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		std::condition_variable _monitor_cv;
+		std::thread _monitor;
+		size_t _core;
+		size_t _max;
+		bool _eager;
+		bool _stop;
+
+		// Tasks in the queues, including those already claimed by a
+		// TaskGroup, but not yet popped.
+		std::atomic_size_t _queued;
+		std::atomic_size_t _started;
+		std::atomic_size_t _idle;
+		std::atomic_size_t _nworkers;
+
+		void start_worker(void);
+		void work(size_t slot);
+		void monitor(void);
+		void wake(void);
+		bool pop(Worker&, bool back, TaskPtr&);
+		TaskPtr find_task(int slot);
+
+	public:
+		/// Start `core` workers, and allow up to `max` of them. If
+		/// `core` is zero, one worker per CPU is started.
+		Executor(size_t core = 0, size_t max = MAX_WORKERS,
+		         bool eager = false);
+		~Executor();
+		Executor(const Executor&) = delete;
+		Executor& operator=(const Executor&) = delete;
+
+		/// Queue the task, and return at once. Exceptions thrown by
+		/// the task are logged, and otherwise dropped.
+		void submit(Function&&);
+
+		/// Queue the task, and return it, so that the caller can
+		/// claim and run it, if no worker has started it yet.
+		TaskPtr spawn(Function&&);
+
+		/// Run a task that the caller has claimed.
+		void run(const TaskPtr&);
+
+		/// Change the core and the maximum number of workers. Extra
+		/// workers go away once they are idle.
+		void set_size(size_t core, size_t max = MAX_WORKERS);
+
+		size_t core_size(void) const { return _core; }
+		size_t max_size(void) const { return _max; }
+
+		/// The number of workers running right now.
+		size_t size(void) const { return _nworkers; }
+};
+
+/// The executor shared by the whole process. It is never destroyed,
+/// so that tasks that never finish do not hold up the exit.
+Executor& executor();
+
+/// The executor for tasks that no one waits for, e.g. the children of
+/// a ParallelLink. It is eager, so that each task starts right away,
+/// as it would on a thread of its own; but it has at most
+/// MAX_WORKERS threads, and tasks beyond that wait for a free one.
+/// Like executor(), it is never destroyed.
+Executor& detached_executor();
+
+/**
+ * A set of tasks that are run on an Executor, and then waited for,
+ * all together; in effect, a future for all of them. While it waits,
+ * the waiting thread runs those tasks of the group that no worker has
+ * started yet. Thus, nested groups, as in trees of ThreadJoinLinks,
+ * never deadlock, no matter how few workers there are; and a waiting
+ * thread never gets stuck in some unrelated, long-running task.
+ */
+class TaskGroup
+{
+	private:
+		Executor& _exec;
+		std::vector<Executor::TaskPtr> _tasks;
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		size_t _pending;
+		std::exception_ptr _ex;
+
+		void finish(std::exception_ptr);
+		void call(const Executor::Function&);
+
+	public:
+		TaskGroup(Executor& ex = executor());
+		~TaskGroup();
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		void run(Executor::Function&&);
+
+		/// Wait for all of the tasks to finish. If any of them threw,
+		/// the first exception thrown is rethrown here.
+		void wait(void);
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_EXECUTOR_H
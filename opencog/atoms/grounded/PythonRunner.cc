@@ -34,10 +34,37 @@
 using namespace opencog;
 
 PythonRunner::PythonRunner(std::string s)
-	: _fname(s)
+	: _fname(s), _pyfn(nullptr), _applier(nullptr)
 {
 }
 
+PythonRunner::~PythonRunner()
+{
+	PythonFunction* pyfn = _pyfn.load();
+	if (pyfn) _applier.load()->release_function(pyfn);
+}
+
+/// Resolve the function name on first use, and keep it. This avoids
+/// re-parsing the name, and walking the modules, on every call.
+/// Resolution is racy only in the benign sense: if two threads
+/// resolve at the same time, one of the results is thrown away.
+const PythonFunction* PythonRunner::get_function(void)
+{
+	PythonFunction* pyfn = _pyfn.load();
+	if (pyfn) return pyfn;
+
+	PythonEval* applier = get_evaluator_for_python(nullptr);
+	pyfn = applier->resolve_function(_fname);
+	_applier.store(applier);
+
+	PythonFunction* expected = nullptr;
+	if (_pyfn.compare_exchange_strong(expected, pyfn))
+		return pyfn;
+
+	applier->release_function(pyfn);
+	return expected;
+}
+
 // ----------------------------------------------------------
 
 /// `execute()` -- evaluate a PythonRunner with arguments.
@@ -63,7 +90,7 @@ ValuePtr PythonRunner::execute(AtomSpace* as,
 
 	PythonEval* applier = get_evaluator_for_python(as);
 
-	return applier->apply_v(as, _fname, args);
+	return applier->apply_v(as, get_function(), args);
 }
 
 ValuePtr PythonRunner::evaluate(AtomSpace* as,
@@ -79,5 +106,6 @@ ValuePtr PythonRunner::evaluate(AtomSpace* as,
 
 	PythonEval* applier = get_evaluator_for_python(as);
 
-	return CastToValue(applier->apply_tv(as, _fname, args));
+	return CastToValue(TruthValueCast(
+		applier->apply_v(as, get_function(), args)));
 }
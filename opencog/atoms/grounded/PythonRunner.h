@@ -24,6 +24,7 @@
 #ifndef _OPENCOG_PYTHON_RUNNER_H
 #define _OPENCOG_PYTHON_RUNNER_H
 
+#include <atomic>
 #include <string>
 #include <opencog/atoms/grounded/Runner.h>
 
@@ -33,15 +34,27 @@ namespace opencog
  *  @{
  */
 
+class PythonEval;
+struct PythonFunction;
+
 /// Base class for executing Python code.
 class PythonRunner : public Runner
 {
 	std::string _fname;
 
+	// The function name, resolved at first use.
+	std::atomic<PythonFunction*> _pyfn;
+
+	// The evaluator that resolved it; it also releases it, so that
+	// tear-down does not have to load or create an evaluator.
+	std::atomic<PythonEval*> _applier;
+	const PythonFunction* get_function(void);
+
 public:
 	PythonRunner(const std::string);
 	PythonRunner(const PythonRunner&) = delete;
 	PythonRunner& operator=(const PythonRunner&) = delete;
+	virtual ~PythonRunner();
 
 	virtual ValuePtr execute(AtomSpace*, const Handle&, bool=false);
 	virtual ValuePtr evaluate(AtomSpace*, const Handle&, bool=false);
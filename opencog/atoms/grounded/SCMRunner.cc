@@ -32,10 +32,28 @@
 using namespace opencog;
 
 SCMRunner::SCMRunner(std::string s)
-	: _fname(s)
+	: _fname(s), _fsym(SCM_BOOL_F)
 {
 }
 
+static void * c_wrap_unprotect(void * p)
+{
+	scm_gc_unprotect_object(*((SCM *) p));
+	return nullptr;
+}
+
+// The symbol was protected by intern_proc(); release it again.
+static void unprotect(SCM var)
+{
+	if (scm_is_false(var)) return;
+	scm_with_guile(c_wrap_unprotect, &var);
+}
+
+SCMRunner::~SCMRunner()
+{
+	unprotect(_fsym.load());
+}
+
 static void throwSyntaxException(bool silent, const char* message...)
 {
 	if (silent)
@@ -70,7 +88,25 @@ ValuePtr SCMRunner::execute(AtomSpace* as,
 	Handle args(force_execute(as, cargs, silent));
 
 	SchemeEval* applier = get_evaluator_for_scheme(as);
-	ValuePtr vp = applier->apply_v(_fname, args);
+
+	// Make a symbol of the name once, and apply that after that. The
+	// procedure itself is looked up in the current module, at each
+	// call, just as evaluating the name would do.
+	SCM fsym = _fsym.load();
+	if (scm_is_false(fsym))
+	{
+		// If another thread got there first, keep its symbol, and
+		// release ours.
+		fsym = applier->intern_proc(_fname);
+		SCM expected = SCM_BOOL_F;
+		if (not _fsym.compare_exchange_strong(expected, fsym))
+		{
+			unprotect(fsym);
+			fsym = expected;
+		}
+	}
+
+	ValuePtr vp(applier->apply_proc(fsym, args));
 
 	// Hmmm... well, a bad scheme function can end up returning a
 	// null pointer. We can convert this to a VoidValue... or we
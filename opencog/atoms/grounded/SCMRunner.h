@@ -24,7 +24,9 @@
 #ifndef _OPENCOG_SCM_RUNNER_H
 #define _OPENCOG_SCM_RUNNER_H
 
+#include <atomic>
 #include <string>
+#include <libguile.h>
 #include <opencog/atoms/grounded/Runner.h>
 
 namespace opencog
@@ -38,10 +40,14 @@ class SCMRunner : public Runner
 {
 	std::string _fname;
 
+	// The procedure name, as a guile symbol; made at first use.
+	std::atomic<SCM> _fsym;
+
 public:
 	SCMRunner(const std::string);
 	SCMRunner(const SCMRunner&) = delete;
 	SCMRunner& operator=(const SCMRunner&) = delete;
+	virtual ~SCMRunner();
 
 	virtual ValuePtr execute(AtomSpace*, const Handle&, bool=false);
 	virtual ValuePtr evaluate(AtomSpace* as, const Handle& args, bool silent=false)
@@ -78,6 +78,7 @@ ValuePtr DualLink::execute(AtomSpace* as, bool silent)
 {
 	if (nullptr == as) as = _atom_space;
 	Recognizer reco(as);
+	reco.visit_in_place = true;
 	reco.satisfy(PatternLinkCast(get_handle()));
 
 	// If there is an anchor, then attach results to the anchor.
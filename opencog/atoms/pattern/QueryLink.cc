@@ -23,6 +23,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <thread>
+
+#include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/query/Implicator.h>
@@ -122,6 +125,31 @@ void QueryLink::extract_variables(const HandleSeq& oset)
 		_implicand.push_back(oset[i]);
 }
 
+/* ================================================================= */
+/**
+ * Return true if a search that found nothing should run the implicand
+ * anyway.
+ *
+ * There are certain useful queries, where the goal of the query
+ * is to determine that some clause or set of clauses are absent
+ * from the AtomSpace. If the clauses are jointly not found, after
+ * a full and exhaustive search, then we want to run the implicator,
+ * and perform some action. Easier said than done, this code is
+ * currently a bit of a hack. It seems to work, per the AbsentUTest
+ * but is perhaps a bit fragile in its assumptions.
+ *
+ * Theoretical background: the atomspace can be thought of as a
+ * Kripke frame: it holds everything we know "right now". The
+ * AbsentLink is a check for what we don't know, right now.
+ */
+static bool only_absents(Implicator& impl, const Pattern& pat)
+{
+	TermMatchMixin* intu =
+		dynamic_cast<TermMatchMixin*>(&impl);
+	return 0 == pat.pmandatory.size() and 0 < pat.absents.size()
+	    and not intu->optionals_present();
+}
+
 /* ================================================================= */
 /* ================================================================= */
 /**
@@ -169,6 +197,7 @@ QueueValuePtr QueryLink::do_execute(AtomSpace* as, bool silent)
 
 	Implicator impl(as);
 	impl.implicand = this->get_implicand();
+	impl.visit_in_place = true;
 	impl.satisfy(PatternLinkCast(get_handle()));
 
 	// If we got a non-empty answer, just return it.
@@ -178,29 +207,12 @@ QueueValuePtr QueryLink::do_execute(AtomSpace* as, bool silent)
 		return qv;
 
 	// If we are here, then there were zero matches.
-	//
-	// There are certain useful queries, where the goal of the query
-	// is to determine that some clause or set of clauses are absent
-	// from the AtomSpace. If the clauses are jointly not found, after
-	// a full and exhaustive search, then we want to run the implicator,
-	// and perform some action. Easier said than done, this code is
-	// currently a bit of a hack. It seems to work, per the AbsentUTest
-	// but is perhaps a bit fragile in its assumptions.
-	//
-	// Theoretical background: the atomspace can be thought of as a
-	// Kripke frame: it holds everything we know "right now". The
-	// AbsentLink is a check for what we don't know, right now.
-	const Pattern& pat = this->get_pattern();
-	TermMatchMixin* intu =
-		dynamic_cast<TermMatchMixin*>(&impl);
-	if (0 == pat.pmandatory.size() and 0 < pat.absents.size()
-	    and not intu->optionals_present())
+	if (only_absents(impl, this->get_pattern()))
 	{
 		qv->open();
 		for (const Handle& himp: impl.implicand)
 			qv->push(std::move(impl.inst.execute(himp, true)));
 		qv->close();
-		return qv;
 	}
 
 	return qv;
@@ -211,6 +223,76 @@ ValuePtr QueryLink::execute(AtomSpace* as, bool silent)
 	return do_execute(as, silent);
 }
 
+/* ================================================================= */
+
+/// Runs in the worker thread started by execute_stream().
+void QueryLink::do_stream(AtomSpace* as, const QueueValuePtr& qv)
+{
+	try
+	{
+		Implicator impl(as);
+		impl.implicand = this->get_implicand();
+		impl.visit_in_place = true;
+		impl.set_stream(qv);
+		impl.satisfy(PatternLinkCast(get_handle()));
+
+		if (0 == impl.num_results() and
+		    only_absents(impl, this->get_pattern()))
+		{
+			for (const Handle& himp: impl.implicand)
+				qv->push_bounded(impl.inst.execute(himp, true));
+		}
+	}
+	catch (const std::exception& ex)
+	{
+		// There is no one to throw to; the reader just sees the
+		// stream end early.
+		logger().warn("QueryLink: streaming search failed: %s", ex.what());
+	}
+
+	qv->close();
+	qv->writer_done();
+}
+
+namespace {
+
+/// Held only by the readers of a stream, and not by its writer. When
+/// the last reader lets go of the stream, the stream is halted, so
+/// that a writer waiting for room wakes up, and stops.
+struct StreamReaders
+{
+	QueueValuePtr qv;
+	StreamReaders(const QueueValuePtr& q) : qv(q) {}
+	~StreamReaders() { qv->halt(); }
+};
+
+}
+
+QueueValuePtr QueryLink::execute_stream(AtomSpace* as, size_t capacity)
+{
+	if (nullptr == as) as = _atom_space;
+
+	QueueValuePtr qv(createQueueValue());
+	qv->set_capacity(capacity);
+	qv->writer_start();
+
+	// The atomspace halts the stream and waits for the search to
+	// finish, before it goes away.
+	as->add_stream(qv);
+
+	// The thread holds on to the link and the queue, so that either
+	// can be dropped by the caller while the search runs.
+	QueryLinkPtr self(QueryLinkCast(get_handle()));
+	std::thread([self, as, qv]() { self->do_stream(as, qv); }).detach();
+
+	// The caller gets the same queue, but counted separately, so that
+	// an abandoned stream ends, instead of leaving the search blocked
+	// forever.
+	std::shared_ptr<StreamReaders> readers(
+		std::make_shared<StreamReaders>(qv));
+	return QueueValuePtr(readers, qv.get());
+}
+
 DEFINE_LINK_FACTORY(QueryLink, QUERY_LINK)
 
 /* ===================== END OF FILE ===================== */
@@ -44,6 +44,7 @@ protected:
 	void extract_variables(const HandleSeq& oset);
 
 	virtual QueueValuePtr do_execute(AtomSpace*, bool silent);
+	void do_stream(AtomSpace*, const QueueValuePtr&);
 
 public:
 	QueryLink(const HandleSeq&&, Type=QUERY_LINK);
@@ -58,6 +59,16 @@ public:
 	virtual bool is_executable() const { return true; }
 	virtual ValuePtr execute(AtomSpace*, bool silent=false);
 
+	/// Run the query in a new thread, and return the queue that the
+	/// results are written to, as they are found. The search waits
+	/// whenever `capacity` results are waiting to be read (zero means
+	/// no limit), and stops when the reader halts the queue, or when
+	/// the reader drops the last reference to it. If the AtomSpace
+	/// is deleted first, it halts the search and waits for it.
+	/// Repeated results are skipped only if they are among the last
+	/// few written; see RewriteMixin::set_stream().
+	QueueValuePtr execute_stream(AtomSpace*, size_t capacity);
+
 	static Handle factory(const Handle&);
 };
 
@@ -32,15 +32,19 @@ bool FloatValue::operator==(const Value& other) const
 
    const FloatValue* fov = (const FloatValue*) &other;
 
-	if (_value.size() != fov->_value.size()) return false;
-	size_t len = _value.size();
+	// Go through value(), as the rows of a ValueColumn are copied
+	// in only when they are first looked at.
+	const std::vector<double>& mine(value());
+	const std::vector<double>& theirs(fov->value());
+	if (mine.size() != theirs.size()) return false;
+	size_t len = mine.size();
 	for (size_t i=0; i<len; i++)
 		// Compare floats with ULPS, because they are lexicographically
 		// ordered. For technical explanation, see
 		// http://www.cygnus-software.com/papers/comparingfloats/Comparing%20floating%20point%20numbers.htm
-		// if (1.0e-15 < fabs(1.0 - fov->_value[i]/_value[i])) return false;
+		// if (1.0e-15 < fabs(1.0 - theirs[i]/mine[i])) return false;
 #define MAX_ULPS 24
-		if (MAX_ULPS < llabs(*(int64_t*) &(_value[i]) - *(int64_t*)&(fov->_value[i])))
+		if (MAX_ULPS < llabs(*(int64_t*) &(mine[i]) - *(int64_t*)&(theirs[i])))
 			return false;
 	return true;
 }
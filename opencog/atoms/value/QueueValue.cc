@@ -61,29 +61,87 @@ void QueueValue::update() const
 	// Reset, to start with.
 	_value.clear();
 
-	// Loop forever, as long as the queue is open.
+	// Loop until the queue closes and is drained.
+	QueueValue* self = const_cast<QueueValue*>(this);
+	ValuePtr val;
+	while (self->next(val))
+		_value.emplace_back(val);
+}
+
+// ==============================================================
+
+bool QueueValue::push_bounded(ValuePtr&& val)
+{
+	if (0 < _capacity)
+	{
+		std::unique_lock<std::mutex> lck(_flow_mtx);
+		_flow_cv.wait(lck, [&]() {
+			return _halted or
+				concurrent_queue<ValuePtr>::size() < _capacity; });
+	}
+	if (_halted) return false;
+	push(std::move(val));
+	return true;
+}
+
+bool QueueValue::next(ValuePtr& val)
+{
 	try
 	{
-		while (true)
-		{
-			ValuePtr val;
-			const_cast<QueueValue*>(this) -> pop(val);
-			_value.emplace_back(val);
-		}
+		pop(val);
 	}
 	catch (typename concurrent_queue<ValuePtr>::Canceled& e)
-	{}
+	{
+		// The queue closed up. Reopen it just long enough to take
+		// one of the remaining values, if any. The lock keeps other
+		// readers from doing the same thing at the same time.
+		std::lock_guard<std::mutex> lck(_flow_mtx);
+		if (is_empty()) return false;
+		cancel_reset();
+		bool got = try_get(val);
+		cancel();
+		if (not got) return false;
+	}
 
-	// If we are here, the queue closed up. Reopen it
-	// just long enough to drain any remaining values.
-	const_cast<QueueValue*>(this) -> cancel_reset();
-	while (not is_empty())
+	// Make room for a writer waiting in push_bounded().
+	if (0 < _capacity)
 	{
-		ValuePtr val;
-		const_cast<QueueValue*>(this) -> pop(val);
-		_value.emplace_back(val);
+		std::lock_guard<std::mutex> lck(_flow_mtx);
+		_flow_cv.notify_all();
 	}
-	const_cast<QueueValue*>(this) -> cancel();
+	return true;
+}
+
+void QueueValue::halt(void)
+{
+	_halted = true;
+	close();
+
+	std::lock_guard<std::mutex> lck(_flow_mtx);
+	cancel_reset();
+	ValuePtr val;
+	while (try_get(val)) {}
+	cancel();
+	_flow_cv.notify_all();
+}
+
+void QueueValue::writer_start(void)
+{
+	std::lock_guard<std::mutex> lck(_flow_mtx);
+	_writing = true;
+}
+
+void QueueValue::writer_done(void)
+{
+	std::lock_guard<std::mutex> lck(_flow_mtx);
+	_writing = false;
+	_flow_cv.notify_all();
+}
+
+void QueueValue::wait_for_writer(void)
+{
+	std::unique_lock<std::mutex> lck(_flow_mtx);
+	_flow_cv.wait(lck, [&]() { return not _writing; });
 }
 
 // ==============================================================
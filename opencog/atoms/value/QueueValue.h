@@ -23,6 +23,10 @@
 #ifndef _OPENCOG_QUEUE_VALUE_H
 #define _OPENCOG_QUEUE_VALUE_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 #include <opencog/util/concurrent_queue.h>
 #include <opencog/atoms/value/LinkStreamValue.h>
 #include <opencog/atoms/atom_types/atom_types.h>
@@ -38,6 +42,12 @@ namespace opencog
  * QueueValues provide a thread-safe FIFO queue of Values. They are
  * meant to be used for producer-consumer APIs, where the produced
  * values are to be handled in sequential order, in a different thread.
+ *
+ * A QueueValue can also be used as a bounded stream. The writer uses
+ * push_bounded(), which waits while the queue holds `capacity` values;
+ * the reader takes values one at a time with next(), and can halt()
+ * the stream when it does not want any more of them. The writer sees
+ * this as a false return from push_bounded(), and should then stop.
  */
 class QueueValue
 	: public LinkStreamValue, public concurrent_queue<ValuePtr>
@@ -46,10 +56,41 @@ protected:
 	QueueValue(Type t) : LinkStreamValue(t) {}
 	virtual void update() const;
 
+	// Flow control for bounded streams. Zero capacity is unbounded.
+	size_t _capacity = 0;
+	std::atomic_bool _halted{false};
+	bool _writing = false;
+	std::mutex _flow_mtx;
+	std::condition_variable _flow_cv;
+
 public:
 	QueueValue(void) : LinkStreamValue(QUEUE_VALUE) {}
 	QueueValue(const ValueSeq&);
 	virtual ~QueueValue() {}
+
+	/// Set the most values push_bounded() lets pile up. Set this
+	/// before the writer starts.
+	void set_capacity(size_t n) { _capacity = n; }
+	size_t get_capacity(void) const { return _capacity; }
+
+	/// Push, first waiting for room if the queue is bounded. Returns
+	/// false, and drops the value, if the reader has halted.
+	bool push_bounded(ValuePtr&&);
+
+	/// Take the next value, waiting for one if need be. Returns false
+	/// once the queue is closed and empty.
+	bool next(ValuePtr&);
+
+	/// The reader does not want any more values. Closes the queue,
+	/// drops whatever is still in it, and wakes up a waiting writer.
+	void halt(void);
+	bool is_halted(void) const { return _halted; }
+
+	/// A writer running in another thread marks when it starts and
+	/// finishes, so that others can wait for it to be done.
+	void writer_start(void);
+	void writer_done(void);
+	void wait_for_writer(void);
 };
 
 typedef std::shared_ptr<QueueValue> QueueValuePtr;
@@ -0,0 +1,144 @@
+/*
+ * opencog/atomspace/AtomIdIndex.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ATOMIDINDEX_H
+#define _OPENCOG_ATOMIDINDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Hands out small, dense integer ids to the atoms of an AtomTable,
+ * and maps ids back to atoms. The ids of extracted atoms are reused,
+ * so that the ids stay dense; thus, an id should not be held on to
+ * after its atom has been extracted.
+ *
+ * The id of each atom is also kept on the atom itself, so that the
+ * mapping works in constant time both ways. Not thread-safe; the
+ * AtomTable guards it with its own lock.
+ */
+class AtomIdIndex
+{
+	private:
+		HandleSeq _atoms;
+		std::vector<AtomId> _free;
+
+	public:
+		AtomIdIndex(void) {}
+
+		/// Give the atom an id, and return it.
+		AtomId assign(const Handle& h)
+		{
+			AtomId id;
+			if (not _free.empty())
+			{
+				id = _free.back();
+				_free.pop_back();
+				_atoms[id] = h;
+			}
+			else
+			{
+				id = (AtomId) _atoms.size();
+				_atoms.emplace_back(h);
+			}
+			return id;
+		}
+
+		void release(AtomId id)
+		{
+			if (_atoms.size() <= id or nullptr == _atoms[id]) return;
+			_atoms[id] = Handle::UNDEFINED;
+			_free.push_back(id);
+		}
+
+		/// Return the atom with the id, or Handle::UNDEFINED.
+		Handle get(AtomId id) const
+		{
+			if (_atoms.size() <= id) return Handle::UNDEFINED;
+			return _atoms[id];
+		}
+
+		/// All ids are less than this.
+		size_t bound(void) const { return _atoms.size(); }
+
+		/// The number of atoms that have an id.
+		size_t size(void) const { return _atoms.size() - _free.size(); }
+
+		/// The atoms, indexed by id; free ids hold Handle::UNDEFINED.
+		const HandleSeq& atoms(void) const { return _atoms; }
+
+		void clear(void)
+		{
+			_atoms.clear();
+			_free.clear();
+		}
+};
+
+typedef std::shared_ptr<AtomIdIndex> AtomIdIndexPtr;
+
+/**
+ * The graph formed by a subset of the atoms of an AtomTable, in
+ * compressed sparse row (CSR) form. The graph has one vertex per
+ * atom, numbered 0 to N-1, and one edge from each link to each atom
+ * in its outgoing set, provided that atom is in the subset, too. If
+ * the table hands out atom ids, the vertices are in order of
+ * increasing atom id; if not, they are in no particular order.
+ *
+ * The outgoing edges of vertex v are out_edges[out_offsets[v]] up to,
+ * but not including, out_edges[out_offsets[v+1]], in the order of the
+ * outgoing set. Likewise for the incoming edges, which are sorted by
+ * vertex. An atom that appears several times in an outgoing set gives
+ * several edges.
+ */
+struct AtomCSR
+{
+	/// The atom at each vertex.
+	HandleSeq atoms;
+	/// The atom id of each vertex, or INVALID_ATOM_ID, if the table
+	/// does not hand out atom ids.
+	std::vector<AtomId> ids;
+	/// The type of each vertex.
+	std::vector<Type> types;
+
+	std::vector<uint64_t> out_offsets;
+	std::vector<uint32_t> out_edges;
+
+	std::vector<uint64_t> in_offsets;
+	std::vector<uint32_t> in_edges;
+
+	size_t num_vertices(void) const { return atoms.size(); }
+	size_t num_edges(void) const { return out_edges.size(); }
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_ATOMIDINDEX_H
@@ -24,7 +24,11 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <list>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #include <stdlib.h>
 
@@ -55,6 +59,7 @@ using namespace opencog;
 AtomSpace::AtomSpace(AtomSpace* parent, bool transient) :
     _atom_table(parent? &parent->_atom_table : nullptr, this, transient),
     _backing_store(nullptr),
+    _batch_store_conn(-1),
     _read_only(false),
     _copy_on_write(transient)
 {
@@ -62,6 +67,30 @@ AtomSpace::AtomSpace(AtomSpace* parent, bool transient) :
 
 AtomSpace::~AtomSpace()
 {
+    // Stop any searches still writing to streams; they must not
+    // touch this atomspace once it is gone.
+    std::vector<std::weak_ptr<QueueValue>> streams;
+    {
+        std::lock_guard<std::mutex> lck(_streams_mtx);
+        streams.swap(_streams);
+    }
+    for (const std::weak_ptr<QueueValue>& w : streams) {
+        QueueValuePtr qv(w.lock());
+        if (nullptr == qv) continue;
+        qv->halt();
+        qv->wait_for_writer();
+    }
+}
+
+void AtomSpace::add_stream(const QueueValuePtr& qv)
+{
+    std::lock_guard<std::mutex> lck(_streams_mtx);
+
+    // Forget the streams that are gone.
+    _streams.erase(std::remove_if(_streams.begin(), _streams.end(),
+        [](const std::weak_ptr<QueueValue>& w) { return w.expired(); }),
+        _streams.end());
+    _streams.emplace_back(qv);
 }
 
 void AtomSpace::ready_transient(AtomSpace* parent)
@@ -277,6 +306,18 @@ void AtomSpace::registerBackingStore(BackingStore *bs)
             "AtomSpace is already connected to a BackingStore.");
 
     _backing_store = bs;
+
+    if (bs->storeOnCommit())
+        _batch_store_conn = _atom_table.atomBatchSignal().connect(
+            [this](const HandleSeq& added, const HandleSeq& removed,
+                   const HandleSeq& changed)->void
+            {
+                BackingStore* store = _backing_store;
+                if (nullptr == store or _read_only) return;
+                HandleSeq hseq(added);
+                hseq.insert(hseq.end(), changed.begin(), changed.end());
+                if (not hseq.empty()) store->storeBatch(hseq);
+            });
 }
 
 void AtomSpace::unregisterBackingStore(BackingStore *bs)
@@ -285,7 +326,12 @@ void AtomSpace::unregisterBackingStore(BackingStore *bs)
         throw RuntimeException(TRACE_INFO,
             "AtomSpace is not connected to a BackingStore.");
 
-    if (bs == _backing_store) _backing_store = nullptr;
+    if (bs != _backing_store) return;
+    _backing_store = nullptr;
+    if (0 <= _batch_store_conn) {
+        _atom_table.atomBatchSignal().disconnect(_batch_store_conn);
+        _batch_store_conn = -1;
+    }
 }
 
 // ====================================================================
@@ -316,6 +362,10 @@ Handle AtomSpace::add_node(Type t, std::string&& name)
     // in the atomspace, return it.
     if (_read_only) return _atom_table.getHandle(t, std::move(name));
 
+    // If we already have it, avoid building a throw-away atom.
+    Handle h(_atom_table.findNode(t, name));
+    if (h) return h;
+
     return _atom_table.add(createNode(t, std::move(name)));
 }
 
@@ -330,8 +380,12 @@ Handle AtomSpace::add_link(Type t, HandleSeq&& outgoing)
     // in the atomspace, return it.
     if (_read_only) return _atom_table.getHandle(t, std::move(outgoing));
 
+    // If we already have it, avoid building a throw-away atom.
+    Handle h(_atom_table.findLink(t, outgoing));
+    if (h) return h;
+
     // If it is a DeleteLink, then the addition will fail. Deal with it.
-    Handle h(createLink(std::move(outgoing), t));
+    h = createLink(std::move(outgoing), t);
     try {
         return _atom_table.add(h);
     }
@@ -433,7 +487,30 @@ bool AtomSpace::remove_atom(Handle h, bool recursive)
     // used to free up RAM storage.
     if (_backing_store and not _read_only)
         _backing_store->removeAtom(h, recursive);
-    return 0 < _atom_table.extract(h, recursive).size();
+    HandleSet removed(_atom_table.extract(h, recursive));
+    note_removals(removed, recursive);
+    return 0 < removed.size();
+}
+
+bool AtomSpace::extract_atom(Handle h, bool recursive)
+{
+    HandleSet removed(_atom_table.extract(h, recursive));
+    note_removals(removed, recursive);
+    return 0 < removed.size();
+}
+
+// Remember the atoms of a copy-on-write space that hid an atom of
+// the parent, so that merge_back() can remove that one, as well.
+void AtomSpace::note_removals(const HandleSet& removed, bool recursive)
+{
+    if (not _copy_on_write or removed.empty()) return;
+    AtomSpace* parent = get_environ();
+    if (nullptr == parent) return;
+
+    std::lock_guard<std::mutex> lck(_merge_mtx);
+    for (const Handle& h : removed)
+        if (parent->_atom_table.getHandle(h))
+            _merge_removals.emplace_back(h, recursive);
 }
 
 // Copy-on-write for setting values.
@@ -477,6 +554,91 @@ Handle AtomSpace::set_value(const Handle& h,
     return Handle::UNDEFINED;
 }
 
+// Run `func(begin, end)` over the index range [0, n), in chunks, as
+// tasks on the shared executor, if n is big enough to be worth it;
+// this is the same as AtomTable::runParts(), but over index ranges.
+// The first exception is re-thrown once all of the tasks are done.
+template <typename Function>
+static void run_ranges(size_t n, Function func)
+{
+    static const size_t CHUNK = 8192;
+    size_t nchunks = (n + CHUNK - 1) / CHUNK;
+    size_t ntasks = std::min(nchunks, (size_t) opencog::num_threads());
+    if (ntasks <= 1) {
+        func(0, n);
+        return;
+    }
+
+    std::atomic_size_t next(0);
+    TaskGroup group;
+    for (size_t i = 0; i < ntasks; i++) {
+        group.run([&]()->void {
+            try {
+                size_t c;
+                while ((c = next++) < nchunks)
+                    func(c * CHUNK, std::min(n, (c + 1) * CHUNK));
+            }
+            catch (...) {
+                // Stop the others early.
+                next = nchunks;
+                throw;
+            }
+        });
+    }
+    group.wait();
+}
+
+ValueSeq AtomSpace::get_values(const HandleSeq& atoms,
+                               const Handle& key) const
+{
+    ValueSeq values(atoms.size());
+    run_ranges(atoms.size(), [&](size_t begin, size_t end)->void {
+        for (size_t i = begin; i < end; i++)
+            values[i] = atoms[i]->getValue(key);
+    });
+    return values;
+}
+
+HandleSeq AtomSpace::set_values(const HandleSeq& atoms,
+                                const Handle& key,
+                                const ValueSeq& values)
+{
+    if (atoms.size() != values.size())
+        throw opencog::RuntimeException(TRACE_INFO,
+             "Got %zu atoms but %zu values", atoms.size(), values.size());
+
+    HandleSeq changed(atoms.size());
+    run_ranges(atoms.size(), [&](size_t begin, size_t end)->void {
+        for (size_t i = begin; i < end; i++)
+            changed[i] = set_value(atoms[i], key, values[i]);
+    });
+    return changed;
+}
+
+ValueSeq AtomSpace::get_values(const std::vector<AtomId>& ids,
+                               const Handle& key) const
+{
+    HandleSeq atoms(_atom_table.getAtomsById(ids));
+    ValueSeq values(atoms.size());
+    run_ranges(atoms.size(), [&](size_t begin, size_t end)->void {
+        for (size_t i = begin; i < end; i++)
+            if (atoms[i]) values[i] = atoms[i]->getValue(key);
+    });
+    return values;
+}
+
+HandleSeq AtomSpace::set_values(const std::vector<AtomId>& ids,
+                                const Handle& key,
+                                const ValueSeq& values)
+{
+    HandleSeq atoms(_atom_table.getAtomsById(ids));
+    for (size_t i = 0; i < atoms.size(); i++)
+        if (nullptr == atoms[i])
+            throw opencog::RuntimeException(TRACE_INFO,
+                 "No atom has the id %u", ids[i]);
+    return set_values(atoms, key, values);
+}
+
 // Copy-on-write for setting truth values.
 Handle AtomSpace::set_truthvalue(const Handle& h, const TruthValuePtr& tvp)
 {
@@ -515,6 +677,56 @@ Handle AtomSpace::set_truthvalue(const Handle& h, const TruthValuePtr& tvp)
     return Handle::UNDEFINED;
 }
 
+void AtomSpace::merge_back(void)
+{
+    AtomSpace* parent = get_environ();
+    if (nullptr == parent)
+        throw opencog::RuntimeException(TRACE_INFO,
+             "No parent atomspace to merge into!");
+
+    if (parent->_read_only)
+        throw opencog::RuntimeException(TRACE_INFO,
+             "Cannot merge into a read-only atomspace!");
+
+    // Adds and extracts on this atomspace wait until the merge is done.
+    std::unique_lock<std::recursive_mutex> lck(_atom_table.hold());
+
+    // Removals first, so that an atom that was extracted here, and
+    // then added again, ends up in the parent.
+    std::vector<std::pair<Handle, bool>> removals;
+    {
+        std::lock_guard<std::mutex> mlck(_merge_mtx);
+        removals.swap(_merge_removals);
+    }
+    for (const auto& pr : removals) {
+        Handle h(parent->_atom_table.getHandle(pr.first));
+        if (h and h->getAtomSpace() == parent)
+            parent->_atom_table.extract(h, pr.second);
+    }
+
+    // Only the atoms in this atomspace; the rest are in the parent
+    // (or its parents) already.
+    HandleSeq hseq;
+    _atom_table.getHandlesByType(back_inserter(hseq), ATOM, true, false);
+
+    // Force-adding an atom that the parent already holds just copies
+    // the values over; the rest are copied into the parent. Forcing
+    // it makes sure that atoms held further up the chain are not
+    // modified; the parent gets its own copy of those, instead.
+    for (const Handle& h : hseq) {
+        Handle ph(parent->_atom_table.add(h, true));
+        if (nullptr == ph or ph == h) continue;
+
+        // The copy here started out with all of the parent's keys;
+        // those it no longer has were removed here.
+        HandleSet keys(h->getKeys());
+        for (const Handle& k : ph->getKeys())
+            if (keys.end() == keys.find(k)) ph->setValue(k, nullptr);
+    }
+
+    _atom_table.clear();
+}
+
 std::string AtomSpace::to_string() const
 {
 	std::stringstream ss;
@@ -29,6 +29,7 @@
 
 #include <opencog/util/exceptions.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
+#include <opencog/atoms/value/QueueValue.h>
 
 #include <opencog/atomspace/AtomTable.h>
 #include <opencog/atomspace/BackingStore.h>
@@ -80,10 +81,30 @@ class AtomSpace
      */
     BackingStore* _backing_store;
 
+    /// Connection of the batch signal to the backing store, if it
+    /// stores on commit; else -1.
+    int _batch_store_conn;
+
     AtomTable& get_atomtable(void) { return _atom_table; }
 
     bool _read_only;
     bool _copy_on_write;
+
+    /**
+     * Atoms that were copied from the parent, and then extracted
+     * here; merge_back() extracts them from the parent, too.
+     */
+    std::mutex _merge_mtx;
+    std::vector<std::pair<Handle, bool>> _merge_removals;
+    void note_removals(const HandleSet&, bool recursive);
+
+    /**
+     * Streams being written by searches running in the background,
+     * over this atomspace. They are halted, and waited for, before
+     * the atomspace goes away.
+     */
+    std::mutex _streams_mtx;
+    std::vector<std::weak_ptr<QueueValue>> _streams;
 protected:
 
     /**
@@ -123,6 +144,29 @@ public:
     void clear_copy_on_write(void) { _copy_on_write = false; }
     bool get_copy_on_write(void) { return _copy_on_write; }
 
+    /// Merge-back. A copy-on-write child of an atomspace can be used
+    /// as a scratch copy of it: creating one copies nothing, and an
+    /// atom is copied into the child, along with all of its values,
+    /// the first time it is changed there. There is no versioning of
+    /// values; each changed atom costs one copy. To start, create a
+    /// new atomspace with this one as the parent, and call
+    /// set_copy_on_write() on it. To discard the changes, delete it.
+    /// To keep them, call merge_back() on it:
+    ///  * every atom in the child is added to the parent; atoms that
+    ///    the parent already holds get the child's values, and lose
+    ///    the keys that were removed in the child;
+    ///  * atoms that the child copied from the parent, and then
+    ///    extracted, are extracted from the parent as well. Atoms are
+    ///    never extracted from further up the chain.
+    /// Afterwards, the child is empty, still copy-on-write, and ready
+    /// to take further changes. Throws if there is no parent, or if
+    /// it is read-only.
+    ///
+    /// The child's table is locked while merging, so that atoms added
+    /// to or extracted from it meanwhile wait for the merge. Values
+    /// set on the child's atoms meanwhile may be lost.
+    void merge_back(void);
+
     /// Get the environment that this atomspace was created in.
     AtomSpace* get_environ() const {
         AtomTable* env = _atom_table.get_environ();
@@ -310,6 +354,37 @@ public:
         _backing_store->storeAtomSpace(_atom_table);
     }
 
+    /**
+     * Use the backing store to store a group of atoms, e.g. the atoms
+     * reported by one batch signal. Committing a batch stores nothing
+     * by itself, unless the backing store asks for it; see
+     * BackingStore::storeOnCommit().
+     */
+    void store_batch(const HandleSeq& hseq, bool synchronous = false) {
+        if (nullptr == _backing_store)
+            throw RuntimeException(TRACE_INFO, "No backing store");
+        _backing_store->storeBatch(hseq, synchronous);
+    }
+
+    /**
+     * Note a stream whose writer runs over this atomspace, in some
+     * other thread; see QueryLink::execute_stream(). The writer must
+     * call writer_start() first, and writer_done() when done, as the
+     * destructor halts the stream, and then waits for the writer.
+     */
+    void add_stream(const QueueValuePtr&);
+
+    /**
+     * Group a sequence of changes, so that they are applied, and
+     * observers hear about them, at once, when the batch is committed.
+     * Other threads are not blocked while a batch is open, and see the
+     * changes only after the commit. See AtomTable::beginBatch() for
+     * details. Prefer the scoped AtomBatch, below, to calling these
+     * directly.
+     */
+    void begin_batch(void) { _atom_table.beginBatch(); }
+    void commit_batch(void) { _atom_table.commitBatch(); }
+
     /**
      * Use the backing store to load the entire incoming set of the
      * atom.
@@ -359,9 +434,7 @@ public:
      * @return True if the Atom for the given Handle was successfully
      *         removed. False, otherwise.
      */
-    bool extract_atom(Handle h, bool recursive=false) {
-        return 0 < _atom_table.extract(h, recursive).size();
-    }
+    bool extract_atom(Handle h, bool recursive=false);
 
     /**
      * Removes an atom from the atomspace, and any attached storage.
@@ -394,6 +467,34 @@ public:
     Handle set_value(const Handle&, const Handle& key, const ValuePtr& value);
     Handle set_truthvalue(const Handle&, const TruthValuePtr&);
 
+    /**
+     * Get the Value at `key` on each of the atoms, in order. Atoms
+     * that have no value at `key` give a null pointer. Large lists
+     * are split over several threads.
+     */
+    ValueSeq get_values(const HandleSeq& atoms, const Handle& key) const;
+
+    /**
+     * Set the Value at `key` on each of the atoms; the i'th value goes
+     * on the i'th atom. This is the same as calling set_value() on each
+     * one, and so has the same copy-on-write semantics; the returned
+     * sequence holds the atoms that were actually changed. Large lists
+     * are split over several threads.
+     */
+    HandleSeq set_values(const HandleSeq& atoms, const Handle& key,
+                         const ValueSeq& values);
+
+    /**
+     * Same as above, for the atoms with the given atom ids; see
+     * enable_atom_ids(). The ids are looked up all at once, under one
+     * lock. Ids that name no atom give a null pointer when getting,
+     * and throw when setting.
+     */
+    ValueSeq get_values(const std::vector<AtomId>& ids,
+                        const Handle& key) const;
+    HandleSeq set_values(const std::vector<AtomId>& ids, const Handle& key,
+                         const ValueSeq& values);
+
     /**
      * Get a node from the AtomTable, if it's in there. If its not found
      * in the AtomTable, and there's a backing store, then the atom will
@@ -506,8 +607,10 @@ public:
     /**
      * Gets a sequence of handles that matches with the given type
      * (subclasses optionally).
-     * Caution: this is slower than using get_handleset_by_type() to
-     * get a set, as it forces the use of a copy to deduplicate atoms.
+     * When this atomspace is nested, and some atom is held in more
+     * than one atomspace of the chain, the results are deduplicated
+     * through a temporary HandleSet, which is slower. Otherwise, the
+     * handles are copied straight out of each atomspace.
      *
      * @param appendToHandles the HandleSeq to which to append the handles.
      * @param type The desired type.
@@ -542,8 +645,10 @@ public:
     /**
      * Gets a container of handles that matches with the given type
      * (subclasses optionally).
-     * Caution: this is slower than using get_handleset_by_type() to
-     * get a set, as it forces the use of a copy to deduplicate atoms.
+     * When this atomspace is nested, and some atom is held in more
+     * than one atomspace of the chain, the results are deduplicated
+     * through a temporary HandleSet, which is slower. Otherwise, the
+     * handles are copied straight out of each atomspace.
      *
      * @param result An output iterator.
      * @param type The desired type.
@@ -569,6 +674,240 @@ public:
         return _atom_table.getHandlesByType(result, type, subclass);
     }
 
+    /**
+     * Invoke the callback on every atom of the given type (subclasses
+     * optionally), spreading the work over multiple threads. The atoms
+     * are copied out of the atomspace first, in chunks of whole hash
+     * buckets, and the atomspace is not locked while the callback runs.
+     * Atoms added after the call starts are not visited.
+     *
+     * The callback is called concurrently, and so must be thread-safe.
+     *
+     * @param func The callback, taking a `const Handle&`.
+     * @param type The desired type.
+     * @param subclass Whether type subclasses should be considered.
+     */
+    template <typename Function> void
+    foreach_parallel_by_type(Function func,
+                             Type type,
+                             bool subclass=false) const
+    {
+        _atom_table.foreachParallelByType(func, type, subclass);
+    }
+
+    /**
+     * Apply `map` to every atom of the given type (subclasses
+     * optionally), in parallel, and combine the results with `reduce`.
+     * The `init` value must be an identity for `reduce`, and `reduce`
+     * must be associative and commutative. See
+     * AtomTable::mapReduceByType() for an example.
+     */
+    template <typename T, typename Map, typename Reduce> T
+    map_reduce_by_type(Type type, bool subclass, const T& init,
+                       Map map, Reduce reduce) const
+    {
+        return _atom_table.mapReduceByType<T>(type, subclass, true,
+                                              init, map, reduce);
+    }
+
+    /**
+     * Copy the atoms of the given type (subclasses optionally) into
+     * about `nparts` parts, for handing out to worker threads. If
+     * `nparts` is zero, a few parts per thread are made.
+     */
+    void get_partitions_by_type(std::vector<HandleSeq>& parts,
+                                Type type,
+                                bool subclass=false,
+                                size_t nparts=0) const
+    {
+        _atom_table.getPartitionsByType(parts, type, subclass, true, nparts);
+    }
+
+    /**
+     * Maintain a sorted index of the atoms of type `t`, ordered by
+     * the `slot`'th number in the FloatValue or NumberNode at `key`.
+     * The index is kept up to date as values change, and is used by
+     * the pattern matcher to start searches that have a GreaterThanLink
+     * on that value. Only the atoms in this atomspace are indexed, and not
+     * those in the parent (if any).
+     *
+     * Example:
+     * @code
+     *         as.add_value_index(EVALUATION_LINK, count_key);
+     * @endcode
+     */
+    ValueIndexPtr add_value_index(Type t, const Handle& key, size_t slot=0)
+    {
+        return _atom_table.addValueIndex(t, key, slot);
+    }
+
+    /// Return the value index, or nullptr, if there isn't one.
+    ValueIndexPtr get_value_index(Type t, const Handle& key,
+                                  size_t slot=0) const
+    {
+        return _atom_table.getValueIndex(t, key, slot);
+    }
+
+    /// Stop maintaining the value index.
+    void remove_value_index(Type t, const Handle& key, size_t slot=0)
+    {
+        _atom_table.removeValueIndex(t, key, slot);
+    }
+
+    /// Return true if there are any value indexes at all.
+    bool have_value_index(void) const
+    {
+        return _atom_table.haveValueIndex();
+    }
+
+    /**
+     * Keep the FloatValues of length `width` at `key`, on the atoms of
+     * type `t`, in one dense matrix, with a row per atom, instead of as
+     * a separate FloatValue on each atom. This is meant for large sets
+     * of same-sized feature vectors, e.g. word embeddings. Atoms get
+     * and set these values just as before; in addition, the column can
+     * be used directly, for batch operations over all of the rows.
+     * Only the atoms in this atomspace are covered, and not those in
+     * the parent (if any). The column finds the rows by atom id, and
+     * so this turns on atom ids; see enable_atom_ids().
+     *
+     * Example:
+     * @code
+     *         ValueColumnPtr col =
+     *             as.add_value_column(WORD_NODE, embed_key, 300);
+     *         col->dot(query, words, scores);
+     * @endcode
+     */
+    ValueColumnPtr add_value_column(Type t, const Handle& key, size_t width)
+    {
+        return _atom_table.addValueColumn(t, key, width);
+    }
+
+    /// Return the value column, or nullptr, if there isn't one.
+    ValueColumnPtr get_value_column(Type t, const Handle& key) const
+    {
+        return _atom_table.getValueColumn(t, key);
+    }
+
+    /// Stop using the value column; its values go back onto the atoms.
+    void remove_value_column(Type t, const Handle& key)
+    {
+        _atom_table.removeValueColumn(t, key);
+    }
+
+    /**
+     * Maintain a sorted index of the names of the nodes of type `t`.
+     * This makes get_nodes_by_prefix() and get_nodes_by_name() fast
+     * for that type. Only the nodes in this atomspace are indexed,
+     * and not those in the parent (if any).
+     */
+    NameIndexPtr add_name_index(Type t)
+    {
+        return _atom_table.addNameIndex(t);
+    }
+
+    /// Return the name index, or nullptr, if there isn't one.
+    NameIndexPtr get_name_index(Type t) const
+    {
+        return _atom_table.getNameIndex(t);
+    }
+
+    /// Stop maintaining the name index.
+    void remove_name_index(Type t)
+    {
+        _atom_table.removeNameIndex(t);
+    }
+
+    /**
+     * Return all nodes of type `t` whose name starts with `prefix`.
+     * If there is no name index for `t`, all nodes of that type are
+     * examined.
+     *
+     * Example:
+     * @code
+     *         HandleSeq hs(as.get_nodes_by_prefix(WORD_NODE, "anti"));
+     * @endcode
+     */
+    HandleSeq get_nodes_by_prefix(Type t, const std::string& prefix) const
+    {
+        return _atom_table.getNodesByPrefix(t, prefix);
+    }
+
+    /// Return all nodes of type `t` whose name contains `sub`.
+    HandleSeq get_nodes_by_substring(Type t, const std::string& sub) const
+    {
+        return _atom_table.getNodesBySubstring(t, sub);
+    }
+
+    /// Return all nodes, of any type, having exactly the given name.
+    HandleSeq get_nodes_by_name(const std::string& name) const
+    {
+        return _atom_table.getNodesByName(name);
+    }
+
+    /**
+     * Give every atom in this atomspace a small, dense integer id, so
+     * that graph algorithms can work over plain arrays, instead of
+     * over Handles. Atoms added later get an id when they are added.
+     * The ids of removed atoms are reused. Only the atoms in this
+     * atomspace get ids, and not those in the parent (if any).
+     *
+     * Example:
+     * @code
+     *         as.enable_atom_ids();
+     *         std::vector<double> rank(as.get_atom_id_bound());
+     *         rank[as.get_atom_id(h)] = 1.0;
+     * @endcode
+     */
+    void enable_atom_ids(void)
+    {
+        _atom_table.enableAtomIds();
+    }
+
+    /// Stop handing out atom ids. Throws if there are value columns,
+    /// as these need the ids.
+    void disable_atom_ids(void)
+    {
+        _atom_table.disableAtomIds();
+    }
+
+    /// Return the id of the atom, or INVALID_ATOM_ID, if it has none.
+    AtomId get_atom_id(const Handle& h) const
+    {
+        return _atom_table.getAtomId(h);
+    }
+
+    /// Return the atom with the given id, or Handle::UNDEFINED.
+    Handle get_atom_by_id(AtomId id) const
+    {
+        return _atom_table.getAtomById(id);
+    }
+
+    /// All atom ids are less than this.
+    size_t get_atom_id_bound(void) const
+    {
+        return _atom_table.getAtomIdBound();
+    }
+
+    /**
+     * Export the graph formed by the atoms of the given types (and
+     * their subtypes, if `subclass` is set): the links point at the
+     * atoms in their outgoing sets. The graph is returned in
+     * compressed sparse row form, with both the outgoing and the
+     * incoming edges; see AtomCSR. The vertices are numbered in order
+     * of atom id if atom ids are on; if they are off, they stay off.
+     *
+     * Example:
+     * @code
+     *         AtomCSR csr;
+     *         as.export_csr(csr, {EVALUATION_LINK, LIST_LINK, WORD_NODE});
+     * @endcode
+     */
+    void export_csr(AtomCSR& csr, const TypeSet& types, bool subclass=true)
+    {
+        _atom_table.exportCSR(csr, types, subclass);
+    }
+
     /**
      * Convert the atomspace into a string
      */
@@ -589,6 +928,44 @@ public:
     {
         return _atom_table.TVChangedSignal();
     }
+    AtomBatchSignal& atomBatchSignal()
+    {
+        return _atom_table.atomBatchSignal();
+    }
+};
+
+/**
+ * A batch of changes to an AtomSpace, open for as long as this object
+ * lives. The batch is committed by commit(), or else when this goes
+ * out of scope, also when that is because of an exception. Thus, the
+ * changes made so far are never lost, nor undone; they are applied,
+ * and signalled, as a group.
+ */
+class AtomBatch
+{
+    AtomSpace& _as;
+    bool _open;
+
+public:
+    AtomBatch(AtomSpace& as) : _as(as), _open(true) { _as.begin_batch(); }
+    AtomBatch(const AtomBatch&) = delete;
+    AtomBatch& operator=(const AtomBatch&) = delete;
+
+    ~AtomBatch()
+    {
+        // The signal handlers run during the commit; they must not
+        // throw out of a destructor.
+        if (not _open) return;
+        try { _as.commit_batch(); }
+        catch (...) {}
+    }
+
+    void commit(void)
+    {
+        if (not _open) return;
+        _open = false;
+        _as.commit_batch();
+    }
 };
 
 /** @}*/
@@ -28,11 +28,13 @@
 
 #include "AtomTable.h"
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <iterator>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 
 #include <stdlib.h>
 
@@ -68,15 +70,28 @@ using namespace opencog;
 // "no atomtable" (in the persist code).
 static std::atomic<UUID> _id_pool(1);
 
+// The size of the membership filter of a new, or just cleared, table.
+// Small, as most tables are transient, and hold only a few atoms.
+static const size_t FILTER_BITS = 1024;
+
 AtomTable::AtomTable(AtomTable* parent, AtomSpace* holder, bool transient) :
     _nameserver(nameserver())
 {
     _as = holder;
-    _environ = parent;
-    if (_environ) _environ->_num_nested++;
     _num_nested = 0;
+    set_environ(parent);
     _uuid = _id_pool.fetch_add(1, std::memory_order_relaxed);
     _transient = transient;
+    _filter = new MembershipFilter(FILTER_BITS);
+    _value_indexes = std::make_shared<const ValueIndexList>();
+    _have_value_index = false;
+    _value_columns = std::make_shared<const ValueColumnList>();
+    _have_value_column = false;
+    _have_name_index = false;
+    _have_atom_ids = false;
+    _has_shadows = false;
+    _nested_shadows = false;
+    _num_batches = 0;
 
     // Connect signal to find out about type additions
     addedTypeConnection =
@@ -88,10 +103,12 @@ AtomTable::~AtomTable()
 {
     std::lock_guard<std::recursive_mutex> lck(_mtx);
 
-    if (_environ) _environ->_num_nested--;
+    if (_environ) _environ->detach_nested(this);
     _nameserver.typeAddedSignal().disconnect(addedTypeConnection);
 
     clear_all_atoms();
+    epoch_manager().retire(_filter.load());
+    epoch_manager().reclaim();
 
     if (0 != _num_nested)
         throw opencog::RuntimeException(TRACE_INFO,
@@ -106,11 +123,55 @@ void AtomTable::ready_transient(AtomTable* parent, AtomSpace* holder)
                 "AtomTable - ready called on non-transient atom table.");
 
     // Set the new parent environment and holder atomspace.
-    _environ = parent;
-    if (_environ) _environ->_num_nested++;
+    if (_environ) _environ->detach_nested(this);
+    set_environ(parent);
     _as = holder;
 }
 
+/// Set the parent environment, and flatten the chain of environments.
+void AtomTable::set_environ(AtomTable* parent)
+{
+    _environ = parent;
+    if (_environ) _environ->attach_nested(this);
+    rebuild_env_chain();
+}
+
+/// Flatten the chain of environments again, for this table, and for
+/// all of the tables nested below it, as theirs include this one.
+/// Readers do not lock the chain; see the comment on _env_chain.
+void AtomTable::rebuild_env_chain(void)
+{
+    if (_environ)
+        _env_chain = _environ->_env_chain;
+    else
+        _env_chain.clear();
+
+    _env_chain.push_back(this);
+    _depth = _env_chain.size() - 1;
+
+    std::lock_guard<std::mutex> lck(_nested_mtx);
+    for (AtomTable* nested : _nested)
+        nested->rebuild_env_chain();
+}
+
+void AtomTable::attach_nested(AtomTable* nested)
+{
+    std::lock_guard<std::mutex> lck(_nested_mtx);
+    _nested.push_back(nested);
+    _num_nested++;
+}
+
+void AtomTable::detach_nested(AtomTable* nested)
+{
+    std::lock_guard<std::mutex> lck(_nested_mtx);
+    _nested.erase(std::remove(_nested.begin(), _nested.end(), nested),
+                  _nested.end());
+
+    // With no nested tables left, no other table can hold copies of
+    // the atoms added here in the meantime.
+    if (0 == --_num_nested) _nested_shadows = false;
+}
+
 void AtomTable::clear_transient()
 {
     if (not _transient)
@@ -123,14 +184,55 @@ void AtomTable::clear_transient()
     clear_all_atoms();
 
     // Clear the  parent environment and holder atomspace.
-    if (_environ) _environ->_num_nested--;
+    if (_environ) _environ->detach_nested(this);
     _environ = NULL;
+    rebuild_env_chain();
     _as = NULL;
 }
 
+// Caller must hold _mtx.
+void AtomTable::filterInsert(ContentHash hsh)
+{
+    MembershipFilter* filt = _filter.load();
+    if (filt->full()) {
+        MembershipFilter* bigger = new MembershipFilter(4 * filt->num_bits());
+        std::for_each(typeIndex.begin(ATOM, true), typeIndex.end(),
+            [&](const Handle& h)->void { bigger->insert(h->get_hash()); });
+        _filter.store(bigger);
+        epoch_manager().retire(filt);
+        epoch_manager().reclaim();
+        filt = bigger;
+    }
+    filt->insert(hsh);
+}
+
+// Caller must hold _mtx.
+void AtomTable::filterReset(void)
+{
+    MembershipFilter* filt = _filter.load();
+    if (FILTER_BITS == filt->num_bits() and filt->empty()) return;
+    _filter.store(new MembershipFilter(FILTER_BITS));
+    epoch_manager().retire(filt);
+    epoch_manager().reclaim();
+}
+
 void AtomTable::clear_all_atoms()
 {
     typeIndex.clear();
+    filterReset();
+    _has_shadows = false;
+    _nested_shadows = false;
+    for (const ValueIndexPtr& vidx : *_value_indexes)
+        vidx->clear();
+    for (const ValueColumnPtr& col : *_value_columns)
+        col->clear();
+    for (const NameIndexPtr& nidx : _name_indexes)
+        nidx->clear();
+    if (_atom_ids) {
+        for (const Handle& h : _atom_ids->atoms())
+            if (h) h->_atom_id = INVALID_ATOM_ID;
+        _atom_ids->clear();
+    }
 }
 
 void AtomTable::clear()
@@ -141,29 +243,126 @@ void AtomTable::clear()
 
 Handle AtomTable::getHandle(Type t, const std::string&& n) const
 {
+    // Plain nodes can be found by probing the index directly; there
+    // is no need to build one, just to hash it.
+    if (_nameserver.isNode(t) and classserver().isPlain(t))
+        return findNode(t, n, Node::content_hash(t, n));
+
     Handle h(createNode(t, std::move(n)));
     return lookupHandle(h);
 }
 
 Handle AtomTable::getHandle(Type t, const HandleSeq&& seq) const
 {
+    if (_nameserver.isLink(t) and classserver().isPlain(t) and
+        std::none_of(seq.begin(), seq.end(),
+            [](const Handle& h)->bool { return nullptr == h; }))
+        return findLink(t, seq, Link::content_hash(t, seq));
+
     Handle h(createLink(std::move(seq), t));
     return lookupHandle(h);
 }
 
+Handle AtomTable::findNode(Type t, const std::string& n) const
+{
+    if (not _nameserver.isNode(t) or not classserver().isPlain(t))
+        return Handle::UNDEFINED;
+    return findNode(t, n, Node::content_hash(t, n));
+}
+
+Handle AtomTable::findNode(Type t, const std::string& n,
+                           ContentHash hsh) const
+{
+    Batch* b = myBatch();
+    if (b) {
+        Handle h(b->find_node(t, n, hsh));
+        if (h) return h;
+        h = findNodeInChain(t, n, hsh);
+        return b->hides(h) ? Handle::UNDEFINED : h;
+    }
+    return findNodeInChain(t, n, hsh);
+}
+
+// As findNode(), but without looking at this thread's batch.
+Handle AtomTable::findNodeInChain(Type t, const std::string& n,
+                                  ContentHash hsh) const
+{
+    EpochGuard guard;
+    for (auto it = _env_chain.rbegin(); it != _env_chain.rend(); it++)
+    {
+        const AtomTable* at = *it;
+        if (not at->mayHold(hsh, guard)) continue;
+        std::lock_guard<std::recursive_mutex> lck(at->_mtx);
+        Handle h(at->typeIndex.findNode(t, n, hsh));
+        if (h) return h;
+    }
+    return Handle::UNDEFINED;
+}
+
+Handle AtomTable::findLink(Type t, const HandleSeq& seq) const
+{
+    if (not _nameserver.isLink(t) or not classserver().isPlain(t))
+        return Handle::UNDEFINED;
+    for (const Handle& h : seq)
+        if (nullptr == h) return Handle::UNDEFINED;
+    return findLink(t, seq, Link::content_hash(t, seq));
+}
+
+Handle AtomTable::findLink(Type t, const HandleSeq& seq,
+                           ContentHash hsh) const
+{
+    Batch* b = myBatch();
+    if (b) {
+        Handle h(b->find_link(t, seq, hsh));
+        if (h) return h;
+        h = findLinkInChain(t, seq, hsh);
+        return b->hides(h) ? Handle::UNDEFINED : h;
+    }
+    return findLinkInChain(t, seq, hsh);
+}
+
+// As findLink(), but without looking at this thread's batch.
+Handle AtomTable::findLinkInChain(Type t, const HandleSeq& seq,
+                                  ContentHash hsh) const
+{
+    EpochGuard guard;
+    for (auto it = _env_chain.rbegin(); it != _env_chain.rend(); it++)
+    {
+        const AtomTable* at = *it;
+        if (not at->mayHold(hsh, guard)) continue;
+        std::lock_guard<std::recursive_mutex> lck(at->_mtx);
+        Handle h(at->typeIndex.findLink(t, seq, hsh));
+        if (h) return h;
+    }
+    return Handle::UNDEFINED;
+}
+
 /// Find an equivalent atom that is exactly the same as the arg. If
 /// such an atom is in the table, it is returned, else return nullptr.
 Handle AtomTable::lookupHandle(const Handle& a) const
 {
     if (nullptr == a) return Handle::UNDEFINED;
 
-    std::lock_guard<std::recursive_mutex> lck(_mtx);
-    Handle h(typeIndex.findAtom(a));
-    if (h) return h;
-
-    if (_environ)
-        return _environ->lookupHandle(a);
+    // This thread's own batch, if any, comes first.
+    Batch* b = myBatch();
+    if (b) {
+        Handle h(b->find_added(a));
+        if (h) return h;
+    }
 
+    // Walk up the environment chain, one table at a time. Only one
+    // table lock is held at any given moment, and tables whose filter
+    // rules the atom out are not locked at all.
+    ContentHash hsh = a->get_hash();
+    EpochGuard guard;
+    for (auto it = _env_chain.rbegin(); it != _env_chain.rend(); it++)
+    {
+        const AtomTable* at = *it;
+        if (not at->mayHold(hsh, guard)) continue;
+        std::lock_guard<std::recursive_mutex> lck(at->_mtx);
+        Handle h(at->typeIndex.findAtom(a));
+        if (h) return (b and b->hides(h)) ? Handle::UNDEFINED : h;
+    }
     return Handle::UNDEFINED;
 }
 
@@ -173,8 +372,10 @@ Handle AtomTable::getHandle(const Handle& a) const
 {
     if (nullptr == a) return Handle::UNDEFINED;
 
-    if (in_environ(a))
-        return a;
+    if (in_environ(a)) {
+        Batch* b = myBatch();
+        return (b and b->hides(a)) ? Handle::UNDEFINED : a;
+    }
 
     return lookupHandle(a);
 }
@@ -203,6 +404,9 @@ Handle AtomTable::add(const Handle& orig, bool force)
     // Can be null, if its a Value
     if (nullptr == orig) return Handle::UNDEFINED;
 
+    Batch* b = myBatch();
+    if (b) return addPending(*b, orig, force);
+
     // Is the atom already in this table, or one of its environments?
     if (not force and in_environ(orig))
         return orig;
@@ -230,8 +434,14 @@ Handle AtomTable::add(const Handle& orig, bool force)
             hcheck->copyValues(orig);
             return hcheck;
         }
+
+        // We are about to hide an atom in some parent table.
+        if (hcheck) _has_shadows = true;
     }
 
+    // Nested tables might already hold a copy of this atom.
+    if (0 < _num_nested) _nested_shadows = true;
+
     // Make a copy of the atom, if needed. Otherwise, use what we were
     // given. Not making a copy saves a lot of time, especially by
     // avoiding running the factories a second time. This is, however,
@@ -273,14 +483,36 @@ Handle AtomTable::add(const Handle& orig, bool force)
     atom->install();
     atom->keep_incoming_set();
 
+    // The filter first, so that the atom is never in the index
+    // without also being in the filter.
+    filterInsert(atom->get_hash());
     typeIndex.insertAtom(atom);
+    // The id first, as the value columns find their rows by id.
+    if (_have_atom_ids)
+        atom->_atom_id = _atom_ids->assign(atom);
+    if (_have_value_column) {
+        // Setting the value again moves it into the column, if it fits.
+        for (const ValueColumnPtr& col : getValueColumns(atom->get_type())) {
+            ValuePtr v(atom->getValue(col->get_key()));
+            if (v) atom->setValue(col->get_key(), v);
+        }
+    }
+    if (_have_value_index) {
+        Type t = atom->get_type();
+        for (const ValueIndexPtr& vidx : *_value_indexes)
+            if (vidx->get_type() == t) vidx->update(atom);
+    }
+    if (_have_name_index and atom->is_node()) {
+        NameIndexPtr nidx(findNameIndex(atom->get_type()));
+        if (nidx) nidx->insert(atom);
+    }
 
     // Unlock, because the signal needs to run unlocked.
     lck.unlock();
 
     // Now that we are completely done, emit the added signal.
     // Don't emit signal until after the indexes are updated!
-    _addAtomSignal.emit(atom);
+    atomAdded(atom);
 
     return atom;
 }
@@ -306,9 +538,8 @@ size_t AtomTable::getNumLinks() const
 
 size_t AtomTable::getNumAtomsOfType(Type type, bool subclass) const
 {
-    std::lock_guard<std::recursive_mutex> lck(_mtx);
-
-    size_t result = typeIndex.size(type);
+    // Find the subclasses only once, not once per table.
+    std::vector<Type> types({type});
     if (subclass)
     {
         // Also count subclasses of this type, if need be.
@@ -316,16 +547,55 @@ size_t AtomTable::getNumAtomsOfType(Type type, bool subclass) const
         for (Type t = ATOM; t<ntypes; t++)
         {
             if (t != type and _nameserver.isA(t, type))
-                result += typeIndex.size(t);
+                types.push_back(t);
         }
     }
 
-    if (_environ)
-        result += _environ->getNumAtomsOfType(type, subclass);
+    size_t result = 0;
+    for (const AtomTable* at : _env_chain)
+    {
+        std::lock_guard<std::recursive_mutex> lck(at->_mtx);
+        for (Type t : types)
+            result += at->typeIndex.size(t);
+    }
 
     return result;
 }
 
+void AtomTable::getPartitionsByType(std::vector<HandleSeq>& parts,
+                                    Type type, bool subclass,
+                                    bool parent, size_t nparts) const
+{
+    // A few parts per thread, so that the threads that finish early
+    // have something left to do.
+    if (0 == nparts) nparts = 4 * opencog::num_threads();
+    size_t part_size = getNumAtomsOfType(type, subclass) / nparts + 1;
+
+    // Duplicates must be weeded out first; the set is then cut up.
+    if (parent and _environ and chain_has_shadows()) {
+        HandleSet hset;
+        getHandleSetByType(hset, type, subclass, parent);
+        for (const Handle& h : hset) {
+            if (parts.empty() or part_size <= parts.back().size())
+                parts.emplace_back();
+            parts.back().emplace_back(h);
+        }
+        return;
+    }
+
+    if (parent and _environ) {
+        for (auto it = _env_chain.rbegin(); it != _env_chain.rend(); it++) {
+            const AtomTable* at = *it;
+            std::lock_guard<std::recursive_mutex> lck(at->_mtx);
+            at->typeIndex.partition(parts, type, subclass, part_size);
+        }
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    typeIndex.partition(parts, type, subclass, part_size);
+}
+
 Handle AtomTable::getRandom(RandGen *rng) const
 {
     size_t x = rng->randint(getSize());
@@ -347,6 +617,9 @@ Handle AtomTable::getRandom(RandGen *rng) const
 
 HandleSet AtomTable::extract(Handle& handle, bool recursive)
 {
+    Batch* b = myBatch();
+    if (b) return extractPending(*b, handle, recursive);
+
     HandleSet result;
 
     // Make sure the atom is fully resolved before we go about
@@ -434,20 +707,667 @@ HandleSet AtomTable::extract(Handle& handle, bool recursive)
     // unlocking it once is not enough, because it can still be
     // recurisvely locked.
     // lck.unlock();
-    _removeAtomSignal.emit(handle);
+    atomRemoved(handle);
     // lck.lock();
 
     typeIndex.removeAtom(handle);
+    if (_have_value_column) {
+        // The atom leaves the table, and so it takes its values along.
+        for (const ValueColumnPtr& col : getValueColumns(handle->get_type())) {
+            ValuePtr v(col->take(handle));
+            if (nullptr == v) continue;
+            bool retired;
+            {
+                std::lock_guard<std::mutex> alck(handle->_mtx);
+                retired = handle->put_value(col->get_key(), v);
+            }
+            if (retired) Atom::reclaim();
+        }
+    }
+    if (_have_name_index and handle->is_node()) {
+        NameIndexPtr nidx(findNameIndex(handle->get_type()));
+        if (nidx) nidx->remove(handle);
+    }
+    if (_have_atom_ids) {
+        _atom_ids->release(handle->_atom_id);
+        handle->_atom_id = INVALID_ATOM_ID;
+    }
 
     // Remove handle from other incoming sets.
     handle->remove();
 
     handle->setAtomSpace(nullptr);
 
+    // Only now, so that setters racing with this cannot re-index it;
+    // see ValueIndex::update().
+    if (_have_value_index) {
+        std::shared_ptr<const ValueIndexList> idxs(
+            std::atomic_load(&_value_indexes));
+        for (const ValueIndexPtr& vidx : *idxs)
+            vidx->remove(handle);
+    }
+
+    result.insert(handle);
+    return result;
+}
+
+ValueIndexPtr AtomTable::addValueIndex(Type t, const Handle& key,
+                                       size_t slot)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    ValueIndexPtr vidx(getValueIndex(t, key, slot));
+    if (vidx) return vidx;
+
+    // Publish the index before filling it. Value setters do not take
+    // _mtx, so a setter that runs during the fill must already see
+    // the index; update() re-reads the value, so order does not matter.
+    vidx = std::make_shared<ValueIndex>(t, key, slot);
+    std::shared_ptr<ValueIndexList> idxs(
+        std::make_shared<ValueIndexList>(*_value_indexes));
+    idxs->push_back(vidx);
+    std::atomic_store(&_value_indexes,
+        std::shared_ptr<const ValueIndexList>(idxs));
+    _have_value_index = true;
+
+    std::for_each(typeIndex.begin(t, false), typeIndex.end(),
+        [&](const Handle& h)->void { vidx->update(h); });
+    return vidx;
+}
+
+ValueIndexPtr AtomTable::getValueIndex(Type t, const Handle& key,
+                                       size_t slot) const
+{
+    std::shared_ptr<const ValueIndexList> idxs(
+        std::atomic_load(&_value_indexes));
+    for (const ValueIndexPtr& vidx : *idxs)
+        if (vidx->is_index_for(t, key, slot)) return vidx;
+    return nullptr;
+}
+
+void AtomTable::removeValueIndex(Type t, const Handle& key, size_t slot)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    std::shared_ptr<ValueIndexList> idxs(
+        std::make_shared<ValueIndexList>(*_value_indexes));
+    auto it = std::find_if(idxs->begin(), idxs->end(),
+        [&](const ValueIndexPtr& vidx)->bool {
+            return vidx->is_index_for(t, key, slot); });
+    if (idxs->end() == it) return;
+    idxs->erase(it);
+    _have_value_index = not idxs->empty();
+    std::atomic_store(&_value_indexes,
+        std::shared_ptr<const ValueIndexList>(idxs));
+}
+
+ValueColumnPtr AtomTable::addValueColumn(Type t, const Handle& key,
+                                         size_t width)
+{
+    if (0 == width)
+        throw InvalidParamException(TRACE_INFO,
+            "A value column must be at least one wide");
+
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    ValueColumnPtr col(getValueColumn(t, key));
+    if (col) {
+        if (col->get_width() != width)
+            throw InvalidParamException(TRACE_INFO,
+                "There already is a value column of width %zu",
+                col->get_width());
+        return col;
+    }
+
+    // The column finds the rows by atom id.
+    enableAtomIds();
+
+    col = std::make_shared<ValueColumn>(t, key, width);
+    std::shared_ptr<ValueColumnList> cols(
+        std::make_shared<ValueColumnList>(*_value_columns));
+    cols->push_back(col);
+    std::atomic_store(&_value_columns,
+        std::shared_ptr<const ValueColumnList>(cols));
+    _have_value_column = true;
+
+    // Move the values that fit into the column. Until it is moved, a
+    // value is still found on the atom, so readers never miss it.
+    std::for_each(typeIndex.begin(t, false), typeIndex.end(),
+        [&](const Handle& h)->void {
+            ValuePtr v(h->getValue(key));
+            if (col->fits(v)) h->setValue(key, v);
+        });
+    return col;
+}
+
+void AtomTable::removeValueColumn(Type t, const Handle& key)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    ValueColumnPtr col(getValueColumn(t, key));
+    if (nullptr == col) return;
+
+    // Put the values back onto the atoms first; while the column is
+    // still in use, readers get the same value from either place.
+    // The views of the rows are put back, and so the atoms keep the
+    // very same values; clear() below copies the rows into them.
+    HandleSeq atoms;
+    std::vector<double> data;
+    col->get_matrix(atoms, data);
+    for (size_t r = 0; r < atoms.size(); r++) {
+        ValuePtr v(col->fetch(atoms[r].operator->()));
+        if (nullptr == v) continue;
+        bool retired;
+        {
+            std::lock_guard<std::mutex> alck(atoms[r]->_mtx);
+            retired = atoms[r]->put_value(col->get_key(), v);
+        }
+        if (retired) Atom::reclaim();
+    }
+
+    std::shared_ptr<ValueColumnList> cols(
+        std::make_shared<ValueColumnList>(*_value_columns));
+    cols->erase(std::find(cols->begin(), cols->end(), col));
+    _have_value_column = not cols->empty();
+    std::atomic_store(&_value_columns,
+        std::shared_ptr<const ValueColumnList>(cols));
+    col->clear();
+}
+
+// Caller must hold _mtx.
+NameIndexPtr AtomTable::findNameIndex(Type t) const
+{
+    for (const NameIndexPtr& nidx : _name_indexes)
+        if (nidx->get_type() == t) return nidx;
+    return nullptr;
+}
+
+NameIndexPtr AtomTable::addNameIndex(Type t)
+{
+    if (not _nameserver.isNode(t))
+        throw opencog::InvalidParamException(TRACE_INFO,
+            "AtomTable - can only index the names of Nodes, not %s",
+            _nameserver.getTypeName(t).c_str());
+
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    NameIndexPtr nidx(findNameIndex(t));
+    if (nidx) return nidx;
+
+    nidx = std::make_shared<NameIndex>(t);
+    std::for_each(typeIndex.begin(t, false), typeIndex.end(),
+        [&](const Handle& h)->void { nidx->insert(h); });
+
+    _name_indexes.push_back(nidx);
+    _have_name_index = true;
+    return nidx;
+}
+
+NameIndexPtr AtomTable::getNameIndex(Type t) const
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    return findNameIndex(t);
+}
+
+void AtomTable::removeNameIndex(Type t)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    auto it = std::find_if(_name_indexes.begin(), _name_indexes.end(),
+        [&](const NameIndexPtr& nidx)->bool {
+            return nidx->get_type() == t; });
+    if (_name_indexes.end() != it)
+        _name_indexes.erase(it);
+    _have_name_index = not _name_indexes.empty();
+}
+
+void AtomTable::enableAtomIds(void)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    if (_atom_ids) return;
+
+    _atom_ids = std::make_shared<AtomIdIndex>();
+    std::for_each(typeIndex.begin(ATOM, true), typeIndex.end(),
+        [&](const Handle& h)->void { h->_atom_id = _atom_ids->assign(h); });
+    _have_atom_ids = true;
+}
+
+void AtomTable::disableAtomIds(void)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    if (nullptr == _atom_ids) return;
+    if (_have_value_column)
+        throw opencog::RuntimeException(TRACE_INFO,
+            "AtomTable - atom ids are in use by the value columns");
+
+    _have_atom_ids = false;
+    for (const Handle& h : _atom_ids->atoms())
+        if (h) h->_atom_id = INVALID_ATOM_ID;
+    _atom_ids = nullptr;
+}
+
+Handle AtomTable::getAtomById(AtomId id) const
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    if (nullptr == _atom_ids) return Handle::UNDEFINED;
+    return _atom_ids->get(id);
+}
+
+HandleSeq AtomTable::getAtomsById(const std::vector<AtomId>& ids) const
+{
+    HandleSeq atoms(ids.size());
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    if (nullptr == _atom_ids) return atoms;
+    for (size_t i = 0; i < ids.size(); i++)
+        atoms[i] = _atom_ids->get(ids[i]);
+    return atoms;
+}
+
+size_t AtomTable::getAtomIdBound(void) const
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    if (nullptr == _atom_ids) return 0;
+    return _atom_ids->bound();
+}
+
+void AtomTable::exportCSR(AtomCSR& csr, const TypeSet& types, bool subclass)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+
+    Type ntypes = _nameserver.getNumberOfClasses();
+    std::vector<bool> wanted(ntypes, false);
+    for (Type t = 0; t < ntypes; t++)
+        for (Type want : types)
+            if (t == want or (subclass and _nameserver.isA(t, want)))
+                wanted[t] = true;
+
+    static const uint32_t NONE = UINT32_MAX;
+    std::vector<uint32_t> vertex;
+    std::unordered_map<const Atom*, uint32_t> local;
+
+    csr = AtomCSR();
+    auto add_vertex = [&](const Handle& h, AtomId id)->uint32_t {
+        uint32_t v = csr.atoms.size();
+        csr.atoms.push_back(h);
+        csr.ids.push_back(id);
+        csr.types.push_back(h->get_type());
+        return v;
+    };
+
+    if (_atom_ids) {
+        // Number the vertices in order of atom id.
+        const HandleSeq& atoms(_atom_ids->atoms());
+        vertex.assign(atoms.size(), NONE);
+        for (AtomId id = 0; id < atoms.size(); id++) {
+            const Handle& h = atoms[id];
+            if (nullptr == h or not wanted[h->get_type()]) continue;
+            vertex[id] = add_vertex(h, id);
+        }
+    } else {
+        // Without atom ids, number the vertices for this export only,
+        // rather than turning ids on for good.
+        std::for_each(typeIndex.begin(ATOM, true), typeIndex.end(),
+            [&](const Handle& h)->void {
+                if (wanted[h->get_type()])
+                    local[h.operator->()] = add_vertex(h, INVALID_ATOM_ID);
+            });
+    }
+    size_t nverts = csr.atoms.size();
+
+    // Atoms in the parent environment are not vertices; their ids,
+    // if any, are from some other table.
+    auto target = [&](const Handle& ho)->uint32_t {
+        if (ho->getAtomSpace() != _as) return NONE;
+        if (_atom_ids) {
+            AtomId id = ho->_atom_id;
+            return id < vertex.size() ? vertex[id] : NONE;
+        }
+        auto it = local.find(ho.operator->());
+        return local.end() != it ? it->second : NONE;
+    };
+
+    csr.out_offsets.reserve(nverts + 1);
+    csr.out_offsets.push_back(0);
+    for (const Handle& h : csr.atoms) {
+        if (h->is_link()) {
+            for (const Handle& ho : h->getOutgoingSet()) {
+                uint32_t v = target(ho);
+                if (NONE != v) csr.out_edges.push_back(v);
+            }
+        }
+        csr.out_offsets.push_back(csr.out_edges.size());
+    }
+
+    // The incoming edges are the outgoing ones, transposed. Since the
+    // sources are visited in order, each vertex gets its incoming
+    // edges sorted.
+    csr.in_offsets.assign(nverts + 1, 0);
+    for (uint32_t v : csr.out_edges)
+        csr.in_offsets[v + 1]++;
+    for (size_t v = 0; v < nverts; v++)
+        csr.in_offsets[v + 1] += csr.in_offsets[v];
+
+    csr.in_edges.resize(csr.out_edges.size());
+    std::vector<uint64_t> fill(csr.in_offsets.begin(), csr.in_offsets.end() - 1);
+    for (uint32_t u = 0; u < nverts; u++)
+        for (uint64_t e = csr.out_offsets[u]; e < csr.out_offsets[u + 1]; e++)
+            csr.in_edges[fill[csr.out_edges[e]]++] = u;
+}
+
+// Walk over all nodes of type t, keeping those whose name matches.
+// Caller must hold _mtx.
+template <typename Pred>
+void AtomTable::scanNames(HandleSeq& hs, Type t, Pred match) const
+{
+    std::for_each(typeIndex.begin(t, false), typeIndex.end(),
+        [&](const Handle& h)->void {
+            if (match(h->get_name())) hs.emplace_back(h);
+        });
+}
+
+// Append the atoms in more to hs, unless an equal atom is already
+// there. Atoms in a child table hide those in the parent.
+static void merge_unique(HandleSeq& hs, const HandleSeq& more)
+{
+    if (more.empty()) return;
+    HandleSet seen(hs.begin(), hs.end());
+    for (const Handle& h : more)
+        if (seen.insert(h).second) hs.emplace_back(h);
+}
+
+HandleSeq AtomTable::getNodesByPrefix(Type t, const std::string& prefix,
+                                      bool parent) const
+{
+    HandleSeq hs;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_mtx);
+        NameIndexPtr nidx(findNameIndex(t));
+        if (nidx)
+            nidx->get_prefix(hs, prefix);
+        else
+            scanNames(hs, t, [&](const std::string& n)->bool {
+                return 0 == n.compare(0, prefix.size(), prefix); });
+    }
+
+    if (parent and _environ)
+        merge_unique(hs, _environ->getNodesByPrefix(t, prefix, parent));
+    return hs;
+}
+
+HandleSeq AtomTable::getNodesBySubstring(Type t, const std::string& sub,
+                                         bool parent) const
+{
+    HandleSeq hs;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_mtx);
+        NameIndexPtr nidx(findNameIndex(t));
+        if (nidx)
+            nidx->get_substring(hs, sub);
+        else
+            scanNames(hs, t, [&](const std::string& n)->bool {
+                return std::string::npos != n.find(sub); });
+    }
+
+    if (parent and _environ)
+        merge_unique(hs, _environ->getNodesBySubstring(t, sub, parent));
+    return hs;
+}
+
+HandleSeq AtomTable::getNodesByName(const std::string& name,
+                                    bool parent) const
+{
+    HandleSeq hs;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_mtx);
+        Type ntypes = _nameserver.getNumberOfClasses();
+        for (Type t = ATOM; t < ntypes; t++)
+        {
+            if (not _nameserver.isNode(t)) continue;
+            NameIndexPtr nidx(findNameIndex(t));
+            if (nidx)
+            {
+                Handle h(nidx->get_exact(name));
+                if (h) hs.emplace_back(h);
+            }
+            else
+                scanNames(hs, t, [&](const std::string& n)->bool {
+                    return n == name; });
+        }
+    }
+
+    if (parent and _environ)
+        merge_unique(hs, _environ->getNodesByName(name, parent));
+    return hs;
+}
+
+// ---------------------------------------------------------------
+// Batched updates.
+
+void AtomTable::atomAdded(const Handle& h)
+{
+    Batch* b = findBatch();
+    if (b) {
+        b->log.push_back({BatchEvent::ADDED, h, nullptr, nullptr});
+        return;
+    }
+    _addAtomSignal.emit(h);
+}
+
+void AtomTable::atomRemoved(const Handle& h)
+{
+    Batch* b = findBatch();
+    if (b) {
+        b->log.push_back({BatchEvent::REMOVED, h, nullptr, nullptr});
+        return;
+    }
+    _removeAtomSignal.emit(h);
+}
+
+Handle AtomTable::Batch::find_added(const Handle& a) const
+{
+    auto range = added.equal_range(a->get_hash());
+    for (auto it = range.first; it != range.second; it++)
+        if (it->second == a or *it->second == *a) return it->second;
+    return Handle::UNDEFINED;
+}
+
+Handle AtomTable::Batch::find_node(Type t, const std::string& n,
+                                   ContentHash hsh) const
+{
+    auto range = added.equal_range(hsh);
+    for (auto it = range.first; it != range.second; it++) {
+        const Handle& h = it->second;
+        if (h->get_type() == t and h->is_node() and h->get_name() == n)
+            return h;
+    }
+    return Handle::UNDEFINED;
+}
+
+Handle AtomTable::Batch::find_link(Type t, const HandleSeq& seq,
+                                   ContentHash hsh) const
+{
+    auto range = added.equal_range(hsh);
+    for (auto it = range.first; it != range.second; it++) {
+        const Handle& h = it->second;
+        if (h->get_type() == t and h->is_link() and
+            h->getOutgoingSet() == seq)
+            return h;
+    }
+    return Handle::UNDEFINED;
+}
+
+// Add an atom to the calling thread's batch. This mirrors add(), but
+// only builds the atom; add() puts it into the table at commit.
+Handle AtomTable::addPending(Batch& b, const Handle& orig, bool force)
+{
+    orig->get_hash();
+
+    Handle hcheck(b.find_added(orig));
+    if (not hcheck) {
+        hcheck = force ? lookupHandle(orig) : getHandle(orig);
+        if (hcheck and force and hcheck->getAtomSpace() != _as)
+            hcheck = Handle::UNDEFINED;
+    }
+    if (hcheck) {
+        if (hcheck != orig) hcheck->copyValues(orig);
+        return hcheck;
+    }
+
+    Handle atom(orig);
+    if (atom->is_link()) {
+        bool need_copy = false;
+        if (atom->getAtomTable())
+            need_copy = true;
+        else
+            for (const Handle& h : atom->getOutgoingSet())
+                if (nullptr == h.operator->() or
+                    not ((in_environ(h) and not b.hides(h)) or
+                         h == b.find_added(h)))
+                { need_copy = true; break; }
+
+        if (need_copy) {
+            HandleSeq closet;
+            closet.reserve(atom->get_arity());
+            for (const Handle& h : atom->getOutgoingSet()) {
+                if (nullptr == h.operator->()) return Handle::UNDEFINED;
+                closet.emplace_back(add(h));
+            }
+            atom = createLink(std::move(closet), atom->get_type());
+        }
+    }
+    else if (atom->getAtomTable())
+    {
+        std::string name(atom->get_name());
+        atom = createNode(atom->get_type(), std::move(name));
+    }
+    if (atom != orig) atom->copyValues(orig);
+
+    b.added.insert({atom->get_hash(), atom});
+    b.ops.push_back({atom, true, force});
+    return atom;
+}
+
+// Extract an atom in the calling thread's batch. Atoms added in this
+// batch are simply dropped from it; others are hidden from this
+// thread, and extract() takes them out of the table at commit.
+HandleSet AtomTable::extractPending(Batch& b, Handle& handle, bool recursive)
+{
+    HandleSet result;
+    if (nullptr == handle) return result;
+
+    Handle pending(b.find_added(handle));
+    if (pending) {
+        // The links added in this batch that hold it.
+        HandleSeq users;
+        for (const auto& pr : b.added) {
+            const Handle& l = pr.second;
+            if (not l->is_link()) continue;
+            const HandleSeq& oset = l->getOutgoingSet();
+            if (oset.end() != std::find(oset.begin(), oset.end(), pending))
+                users.push_back(l);
+        }
+        if (not users.empty() and not recursive) return result;
+        for (Handle& l : users) {
+            HandleSet ex(extractPending(b, l, true));
+            result.insert(ex.begin(), ex.end());
+        }
+
+        auto range = b.added.equal_range(pending->get_hash());
+        for (auto it = range.first; it != range.second; it++)
+            if (it->second == pending) { b.added.erase(it); break; }
+        b.ops.erase(std::remove_if(b.ops.begin(), b.ops.end(),
+            [&](const BatchOp& op)->bool {
+                return op.add and op.atom == pending; }),
+            b.ops.end());
+        handle = pending;
+        result.insert(pending);
+        return result;
+    }
+
+    handle = getHandle(handle);
+    if (nullptr == handle) return result;
+
+    // Atoms further up the chain are not part of this batch.
+    AtomTable* other = handle->getAtomTable();
+    if (other != this)
+        return other->extract(handle, recursive);
+
+    if (not recursive and 0 < handle->getIncomingSet().size())
+        return result;
+
+    b.removed.insert(handle);
+    b.ops.push_back({handle, false, recursive});
     result.insert(handle);
     return result;
 }
 
+void AtomTable::beginBatch(void)
+{
+    std::lock_guard<std::mutex> lck(_batch_mtx);
+    Batch& b = _batches[std::this_thread::get_id()];
+    if (0 == b.depth++) _num_batches++;
+}
+
+void AtomTable::commitBatch(void)
+{
+    Batch* b = myBatch();
+    if (nullptr == b)
+        throw opencog::RuntimeException(TRACE_INFO,
+            "AtomTable - commit without a matching begin!");
+
+    // Only the outermost commit does anything.
+    if (0 < --b->depth) return;
+
+    // Apply the changes, in order, under one lock, so that other
+    // threads see either all of them, or none. The signals are
+    // still logged while this runs.
+    b->applying = true;
+    std::exception_ptr eptr;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_mtx);
+        for (BatchOp& op : b->ops) {
+            try {
+                if (op.add) add(op.atom, op.flag);
+                else extract(op.atom, op.flag);
+            }
+            catch (...) {
+                if (not eptr) eptr = std::current_exception();
+            }
+        }
+    }
+
+    std::vector<BatchEvent> log;
+    log.swap(b->log);
+    {
+        std::lock_guard<std::mutex> lck(_batch_mtx);
+        _batches.erase(std::this_thread::get_id());
+        _num_batches--;
+    }
+
+    // The signals need to run unlocked. Replay them in the order
+    // that the changes were made, so that e.g. an atom that was
+    // removed and then added again is heard of in that order.
+    HandleSeq added;
+    HandleSeq removed;
+    HandleSeq changed;
+    for (const BatchEvent& ev : log) {
+        switch (ev.kind) {
+            case BatchEvent::ADDED:
+                _addAtomSignal.emit(ev.atom);
+                added.emplace_back(ev.atom);
+                break;
+            case BatchEvent::REMOVED:
+                _removeAtomSignal.emit(ev.atom);
+                removed.emplace_back(ev.atom);
+                break;
+            case BatchEvent::TV_CHANGED:
+                _TVChangedSignal.emit(ev.atom, ev.oldtv, ev.newtv);
+                changed.emplace_back(ev.atom);
+                break;
+        }
+    }
+
+    // Nothing to report, e.g. an empty batch.
+    if (not log.empty())
+        _batchSignal.emit(added, removed, changed);
+
+    if (eptr) std::rethrow_exception(eptr);
+}
+
 /// This is the resize callback, when a new type is dynamically added.
 void AtomTable::typeAdded(Type t)
 {
@@ -25,9 +25,16 @@
 #ifndef _OPENCOG_ATOMTABLE_H
 #define _OPENCOG_ATOMTABLE_H
 
+#include <algorithm>
 #include <atomic>
+#include <exception>
 #include <iostream>
+#include <iterator>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <opencog/util/async_method_caller.h>
@@ -35,11 +42,18 @@
 #include <opencog/util/RandGen.h>
 #include <opencog/util/sigslot.h>
 
+#include <opencog/atoms/base/Epoch.h>
+#include <opencog/atoms/execution/Executor.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
 
 #include <opencog/atoms/atom_types/NameServer.h>
 
+#include <opencog/atomspace/AtomIdIndex.h>
+#include <opencog/atomspace/MembershipFilter.h>
+#include <opencog/atomspace/NameIndex.h>
 #include <opencog/atomspace/TypeIndex.h>
+#include <opencog/atomspace/ValueColumn.h>
+#include <opencog/atomspace/ValueIndex.h>
 
 class AtomSpaceUTest;
 class AtomTableUTest;
@@ -55,6 +69,12 @@ typedef SigSlot<const Handle&,
                 const TruthValuePtr&,
                 const TruthValuePtr&> TVCHSigl;
 
+/// Emitted once per batch: the atoms added, the atoms removed, and
+/// the atoms whose TruthValue changed, in the order they happened.
+typedef SigSlot<const HandleSeq&,
+                const HandleSeq&,
+                const HandleSeq&> AtomBatchSignal;
+
 class AtomSpace;
 
 /**
@@ -78,6 +98,94 @@ private:
     //! Index of atoms.
     TypeIndex typeIndex;
 
+    //! Bloom filter over the hashes of the atoms in typeIndex, so that
+    //! lookups up the environment chain can skip tables without
+    //! locking them. Replaced by a larger one, under _mtx, as the
+    //! table grows; the old one is retired through the EpochManager.
+    std::atomic<MembershipFilter*> _filter;
+    void filterInsert(ContentHash);
+    void filterReset(void);
+
+    /// False if this table surely holds no atom with the hash. Takes
+    /// no lock; the caller must be inside the EpochGuard.
+    bool mayHold(ContentHash hsh, const EpochGuard& guard) const
+    {
+        return not guard.active() or _filter.load()->may_contain(hsh);
+    }
+
+    //! Optional indexes of atoms, sorted by value. Changed under _mtx,
+    //! by swapping in a new list, so that value setters need not lock.
+    typedef std::vector<ValueIndexPtr> ValueIndexList;
+    std::shared_ptr<const ValueIndexList> _value_indexes;
+    std::atomic_bool _have_value_index;
+
+    //! Optional columnar stores of values. Changed under _mtx, by
+    //! swapping in a new list, so that it can be read without locking.
+    typedef std::vector<ValueColumnPtr> ValueColumnList;
+    std::shared_ptr<const ValueColumnList> _value_columns;
+    std::atomic_bool _have_value_column;
+
+    //! Optional indexes of nodes, sorted by name. Guarded by _mtx.
+    std::vector<NameIndexPtr> _name_indexes;
+    std::atomic_bool _have_name_index;
+
+    //! Optional dense integer ids of the atoms. Guarded by _mtx.
+    AtomIdIndexPtr _atom_ids;
+    std::atomic_bool _have_atom_ids;
+
+    NameIndexPtr findNameIndex(Type) const;
+    Handle findNode(Type, const std::string&, ContentHash) const;
+    Handle findLink(Type, const HandleSeq&, ContentHash) const;
+    Handle findNodeInChain(Type, const std::string&, ContentHash) const;
+    Handle findLinkInChain(Type, const HandleSeq&, ContentHash) const;
+    template <typename Pred>
+    void scanNames(HandleSeq&, Type, Pred) const;
+
+    /// The number of threads that runParts() will use.
+    static size_t numWorkers(const std::vector<HandleSeq>& parts)
+    {
+        return std::max((size_t) 1,
+            std::min(parts.size(), (size_t) opencog::num_threads()));
+    }
+
+    /// Run `func(thread_index, handle)` on every atom in `parts`,
+    /// as numWorkers() tasks on the shared executor; the calling
+    /// thread runs those that no worker has picked up. Tasks pull
+    /// whole parts off a shared counter, so that uneven parts still
+    /// balance out. Each task has its own thread_index. The first
+    /// exception thrown by `func` is re-thrown here, after all of the
+    /// tasks are done.
+    template <typename Function>
+    static void runParts(const std::vector<HandleSeq>& parts, Function func)
+    {
+        size_t ntasks = numWorkers(parts);
+        if (1 == ntasks) {
+            for (const HandleSeq& part : parts)
+                for (const Handle& h : part)
+                    func(0, h);
+            return;
+        }
+
+        std::atomic_size_t next(0);
+        TaskGroup group;
+        for (size_t thr = 0; thr < ntasks; thr++) {
+            group.run([&, thr]()->void {
+                try {
+                    size_t p;
+                    while ((p = next++) < parts.size())
+                        for (const Handle& h : parts[p])
+                            func(thr, h);
+                }
+                catch (...) {
+                    // Stop the others early.
+                    next = parts.size();
+                    throw;
+                }
+            });
+        }
+        group.wait();
+    }
+
     /// Parent environment for this table.  Null if top-level.
     /// This allows atomspaces to be nested; atoms in this atomspace
     /// can reference those in the parent environment.
@@ -87,6 +195,51 @@ private:
     AtomTable* _environ;
     std::atomic_int _num_nested;
 
+    /// The tables nested directly below this one, so that their
+    /// flattened chains can be rebuilt when this one is re-parented.
+    std::mutex _nested_mtx;
+    std::vector<AtomTable*> _nested;
+    void attach_nested(AtomTable*);
+    void detach_nested(AtomTable*);
+
+    /// The flattened environment: _env_chain[0] is the top-level
+    /// table, and _env_chain[_depth] is this table. This allows
+    /// in_environ() to run in constant time, and lookups to walk up
+    /// the chain without recursing (and without holding the locks of
+    /// all the tables at once).
+    ///
+    /// The chain is read without any lock. It is rebuilt only when a
+    /// table is created or re-parented (ready_transient() and
+    /// clear_transient()), which must not happen while any other
+    /// thread is using this table, or any table nested below it.
+    std::vector<AtomTable*> _env_chain;
+    size_t _depth;
+    void set_environ(AtomTable*);
+    void rebuild_env_chain(void);
+
+    /// Set if this table might hold atoms that are equal to atoms in
+    /// some other table in the same chain. When no table in a chain
+    /// has it set, every atom appears exactly once in the chain, and
+    /// the results from each table can be used as-is, without first
+    /// de-duplicating them in a HandleSet.
+    ///
+    /// _has_shadows is set when an atom in some parent table is
+    /// hidden by a force-add (copy-on-write). _nested_shadows is set
+    /// when an atom is added here while nested tables exist, as they
+    /// might already hold a copy; it only matters to the chains of
+    /// those nested tables, and is cleared once they are all gone.
+    std::atomic_bool _has_shadows;
+    std::atomic_bool _nested_shadows;
+    bool chain_has_shadows(void) const
+    {
+        for (size_t d = 0; d <= _depth; d++) {
+            const AtomTable* at = _env_chain[d];
+            if (at->_has_shadows) return true;
+            if (d < _depth and at->_nested_shadows) return true;
+        }
+        return false;
+    }
+
     // The AtomSpace that is holding us (if any).
     AtomSpace* _as;
     bool _transient;
@@ -105,6 +258,79 @@ private:
     /** Signal emitted when the TV changes. */
     TVCHSigl _TVChangedSignal;
 
+    /** Signal emitted when a batch is committed. */
+    AtomBatchSignal _batchSignal;
+
+    /// Batched updates. While a thread has a batch open on this table,
+    /// the atoms it adds and extracts are not put into, or taken out
+    /// of, the table right away. They are buffered, per thread, and
+    /// applied at commit, under one short hold of _mtx, so that other
+    /// threads see all of them or none. The signals for them, and for
+    /// the TV changes that the thread makes meanwhile, are logged, and
+    /// sent once the changes are applied.
+    struct BatchEvent
+    {
+        enum Kind { ADDED, REMOVED, TV_CHANGED };
+        Kind kind;
+        Handle atom;
+        TruthValuePtr oldtv;
+        TruthValuePtr newtv;
+    };
+    struct BatchOp
+    {
+        Handle atom;
+        bool add;
+        bool flag;    // Force, for adds; recursive, for extracts.
+    };
+    struct Batch
+    {
+        int depth = 0;
+        bool applying = false;
+        std::vector<BatchOp> ops;
+        std::unordered_multimap<ContentHash, Handle> added;
+        UnorderedHandleSet removed;
+        std::vector<BatchEvent> log;
+
+        Handle find_added(const Handle&) const;
+        Handle find_node(Type, const std::string&, ContentHash) const;
+        Handle find_link(Type, const HandleSeq&, ContentHash) const;
+        bool hides(const Handle& h) const
+        {
+            return h and not removed.empty() and
+                   removed.end() != removed.find(h);
+        }
+    };
+    // Each thread only ever uses its own entry; _batch_mtx guards the
+    // map itself. Entries are node-based, so pointers to them are
+    // stable while other threads open and close their own batches.
+    mutable std::mutex _batch_mtx;
+    std::unordered_map<std::thread::id, Batch> _batches;
+    std::atomic_int _num_batches;
+
+    /// The batch of the calling thread, if it has one open; else null.
+    Batch* findBatch(void) const
+    {
+        if (0 == _num_batches) return nullptr;
+        std::lock_guard<std::mutex> lck(_batch_mtx);
+        auto it = _batches.find(std::this_thread::get_id());
+        if (_batches.end() == it) return nullptr;
+        return const_cast<Batch*>(&it->second);
+    }
+
+    /// As findBatch(), but null while the batch is being applied, as
+    /// changes then go to the table itself.
+    Batch* myBatch(void) const
+    {
+        Batch* b = findBatch();
+        return (b and not b->applying) ? b : nullptr;
+    }
+
+    Handle addPending(Batch&, const Handle&, bool force);
+    HandleSet extractPending(Batch&, Handle&, bool recursive);
+
+    void atomAdded(const Handle&);
+    void atomRemoved(const Handle&);
+
     /**
      * Drop copy constructor and equals operator to
      * prevent large object copying by mistake.
@@ -137,6 +363,13 @@ public:
     AtomTable* get_environ(void) const { return _environ; }
     AtomSpace* getAtomSpace(void) const { return _as; }
 
+    /// Hold the table lock for as long as the returned lock lives;
+    /// atoms cannot be added to or extracted from this table meanwhile.
+    std::unique_lock<std::recursive_mutex> hold(void) const
+    {
+        return std::unique_lock<std::recursive_mutex>(_mtx);
+    }
+
     /**
      * Return true if the atom is in this atomtable, or if it is
      * in the environment of this atomtable.
@@ -151,12 +384,12 @@ public:
     {
         if (nullptr == atom) return false;
         AtomTable* atab = atom->getAtomTable();
-        const AtomTable* env = this;
-        while (env) {
-            if (atab == env) return true;
-            env = env->_environ;
-        }
-        return false;
+        if (nullptr == atab) return false;
+
+        // A table at depth d can only be our ancestor if it sits at
+        // position d in our chain.
+        size_t d = atab->_depth;
+        return d <= _depth and _env_chain[d] == atab;
     }
 
     /**
@@ -181,6 +414,16 @@ public:
     Handle getHandle(const Handle&) const;
     Handle lookupHandle(const Handle&) const;
 
+    /**
+     * Find the node or link with the given type and content, without
+     * constructing a throw-away atom first. This works only for types
+     * that are plain Nodes or Links (see ClassServer::isPlain()); for
+     * all other types, Handle::UNDEFINED is returned, and the atom has
+     * to be constructed in order to find it.
+     */
+    Handle findNode(Type, const std::string&) const;
+    Handle findLink(Type, const HandleSeq&) const;
+
     /**
      * Returns the set of atoms of a given type (subclasses optionally).
      *
@@ -247,15 +490,26 @@ public:
                      bool subclass=false,
                      bool parent=true) const
     {
-        // If parent wanted, and parent exists, then we must use the
-        // handleset to disambiguate results.  This causes an extra
-        // copy of the handles, unfortunately.
-        if (parent and _environ) {
+        // If parent wanted, and parent exists, then we might have to
+        // use the handleset to disambiguate results.  This causes an
+        // extra copy of the handles, unfortunately.
+        if (parent and _environ and chain_has_shadows()) {
            HandleSet hset;
            getHandleSetByType(hset, type, subclass, parent);
            return std::copy(hset.begin(), hset.end(), result);
         }
 
+        // No duplicates anywhere ... avoid the copy above.
+        if (parent and _environ) {
+           for (auto it = _env_chain.rbegin(); it != _env_chain.rend(); it++) {
+               const AtomTable* at = *it;
+               std::lock_guard<std::recursive_mutex> lck(at->_mtx);
+               result = std::copy(at->typeIndex.begin(type, subclass),
+                                  at->typeIndex.end(), result);
+           }
+           return result;
+        }
+
         // No parent ... avoid the copy above.
         std::lock_guard<std::recursive_mutex> lck(_mtx);
         return std::copy(typeIndex.begin(type, subclass),
@@ -269,13 +523,13 @@ public:
                         bool subclass=false,
                         bool parent=true) const
     {
-        // If parent wanted, and parent exists, then we must use the
-        // handleset to disambiguate results.  This causes an extra
-        // copy of the handles, unfortunately.
+        // If parent wanted, and parent exists, then we must copy the
+        // handles out of the tables, and disambiguate them, if needed.
+        // This causes an extra copy of the handles, unfortunately.
         if (parent and _environ) {
-           HandleSet hset;
-           getHandleSetByType(hset, type, subclass, parent);
-           std::for_each(hset.begin(), hset.end(),
+           HandleSeq hseq;
+           getHandlesByType(std::back_inserter(hseq), type, subclass, parent);
+           std::for_each(hseq.begin(), hseq.end(),
                 [&](const Handle& h)->void {
                      (func)(h);
                 });
@@ -292,46 +546,73 @@ public:
              });
     }
 
+    /**
+     * Copy the atoms of the given type (and subtypes, optionally) into
+     * `parts`, for handing out to worker threads. Each table is locked
+     * only while its atoms are being copied; later changes to the
+     * table are not seen in the parts. If `nparts` is zero, a few
+     * parts per thread are made. Parts are cut between hash buckets,
+     * and so they are only approximately equal in size.
+     */
+    void getPartitionsByType(std::vector<HandleSeq>& parts,
+                             Type type,
+                             bool subclass=false,
+                             bool parent=true,
+                             size_t nparts=0) const;
+
     template <typename Function> void
     foreachParallelByType(Function func,
                         Type type,
                         bool subclass=false,
                         bool parent=true) const
     {
-        // If parent wanted, and parent exists, then we must use the
-        // handleset to disambiguate results.  This causes an extra
-        // copy of the handles, unfortunately.
-        if (parent and _environ) {
-           HandleSet hset;
-           getHandleSetByType(hset, type, subclass, parent);
-
-           // Parallelize, always, no matter what!
-           opencog::setting_omp(opencog::num_threads(), 1);
-
-           OMP_ALGO::for_each(hset.begin(), hset.end(),
-                [&](const Handle& h)->void {
-                     (func)(h);
-                });
-
-           // Reset to default.
-           opencog::setting_omp(opencog::num_threads());
-           return;
-        }
-
-        // No parent ... avoid the copy above.
-        // This can (will) deadlock if func touches the table.
-        std::lock_guard<std::recursive_mutex> lck(_mtx);
-        // Parallelize, always, no matter what!
-        opencog::setting_omp(opencog::num_threads(), 1);
-
-        OMP_ALGO::for_each(typeIndex.begin(type, subclass),
-                      typeIndex.end(),
-             [&](const Handle& h)->void {
-                  (func)(h);
-             });
+        // Take a snapshot, and then run unlocked; thus, func can
+        // touch the table without deadlocking.
+        std::vector<HandleSeq> parts;
+        getPartitionsByType(parts, type, subclass, parent);
+
+        runParts(parts, [&](size_t, const Handle& h)->void {
+            (func)(h);
+        });
+    }
 
-        // Reset to default.
-        opencog::setting_omp(opencog::num_threads());
+    /**
+     * Map-reduce over all atoms of the given type (subclasses
+     * optionally). The `map` function is applied to each atom, and the
+     * results are combined with `reduce`, first within each thread,
+     * and then across threads. The `init` value must be an identity
+     * for `reduce` (e.g. zero, for a sum), as it is used once per
+     * thread. `reduce` must be associative and commutative, as the
+     * order in which atoms are visited is not defined.
+     *
+     * Example: count the links having a non-default truth value:
+     * @code
+     *     size_t n = atab.mapReduceByType<size_t>(LINK, true, true, 0,
+     *          [](const Handle& h)->size_t {
+     *              return h->getTruthValue()->isDefaultTV() ? 0 : 1; },
+     *          [](size_t a, size_t b)->size_t { return a + b; });
+     * @endcode
+     */
+    template <typename T, typename Map, typename Reduce> T
+    mapReduceByType(Type type,
+                    bool subclass,
+                    bool parent,
+                    const T& init,
+                    Map map,
+                    Reduce reduce) const
+    {
+        std::vector<HandleSeq> parts;
+        getPartitionsByType(parts, type, subclass, parent);
+
+        std::vector<T> accs(numWorkers(parts), init);
+        runParts(parts, [&](size_t thr, const Handle& h)->void {
+            accs[thr] = reduce(accs[thr], map(h));
+        });
+
+        T result(init);
+        for (const T& acc : accs)
+            result = reduce(result, acc);
+        return result;
     }
 
     /**
@@ -381,11 +662,223 @@ public:
      */
     Handle getRandom(RandGen* rng) const;
 
+    /**
+     * Create a value index for the atoms of the given type, sorted
+     * by the `slot`'th number of the FloatValue at `key`. If such an
+     * index already exists, it is returned; otherwise a new one is
+     * created, and filled with the atoms currently in this table.
+     *
+     * Only the atoms in this table are indexed; those in the parent
+     * environment (if any) are not.
+     */
+    ValueIndexPtr addValueIndex(Type, const Handle& key, size_t slot=0);
+
+    /** Return the value index, or nullptr if there is none. */
+    ValueIndexPtr getValueIndex(Type, const Handle& key, size_t slot=0) const;
+
+    /** Stop maintaining the value index. */
+    void removeValueIndex(Type, const Handle& key, size_t slot=0);
+
+    bool haveValueIndex(void) const { return _have_value_index; }
+
+    /**
+     * Called by Atom::setValue() whenever a value changes, so that
+     * the value indexes can be kept up to date. Inlined, for the same
+     * reason as in_environ() above. Only the lock of each affected
+     * index is taken, so that value setters do not serialize on _mtx.
+     */
+    void valueChanged(const Handle& atom, const Handle& key)
+    {
+        if (not _have_value_index) return;
+        std::shared_ptr<const ValueIndexList> idxs(
+            std::atomic_load(&_value_indexes));
+        Type t = atom->get_type();
+        for (const ValueIndexPtr& vidx : *idxs)
+            if (vidx->covers(t, key)) vidx->update(atom);
+    }
+
+    /**
+     * Keep the FloatValues of width `width` at `key`, on the atoms of
+     * type `t`, in one dense matrix, instead of on each atom. If such
+     * a column already exists, it is returned, provided it has the
+     * same width; else this throws. The matching values already on
+     * the atoms in this table are moved into the new column.
+     *
+     * Only the atoms in this table are covered; those in the parent
+     * environment (if any) are not.
+     */
+    ValueColumnPtr addValueColumn(Type, const Handle& key, size_t width);
+
+    /** Return the value column, or nullptr if there is none. */
+    ValueColumnPtr getValueColumn(Type t, const Handle& key) const
+    {
+        if (not _have_value_column) return nullptr;
+        std::shared_ptr<const ValueColumnList> cols(
+            std::atomic_load(&_value_columns));
+        for (const ValueColumnPtr& col : *cols)
+            if (col->covers(t, key)) return col;
+        return nullptr;
+    }
+
+    /** Return all of the value columns for the atom type. */
+    ValueColumnList getValueColumns(Type t) const
+    {
+        ValueColumnList found;
+        if (not _have_value_column) return found;
+        std::shared_ptr<const ValueColumnList> cols(
+            std::atomic_load(&_value_columns));
+        for (const ValueColumnPtr& col : *cols)
+            if (col->get_type() == t) found.push_back(col);
+        return found;
+    }
+
+    /**
+     * Stop using the value column. The values in it are moved back
+     * onto the atoms. This should not be done while other threads
+     * are setting values at the key.
+     */
+    void removeValueColumn(Type, const Handle& key);
+
+    bool haveValueColumn(void) const { return _have_value_column; }
+
+    /**
+     * Create a name index for the nodes of the given type. If such an
+     * index already exists, it is returned; otherwise a new one is
+     * created, and filled with the nodes currently in this table.
+     * Throws if the type is not a Node type.
+     *
+     * Only the nodes in this table are indexed; those in the parent
+     * environment (if any) are not.
+     */
+    NameIndexPtr addNameIndex(Type);
+
+    /** Return the name index, or nullptr if there is none. */
+    NameIndexPtr getNameIndex(Type) const;
+
+    /** Stop maintaining the name index. */
+    void removeNameIndex(Type);
+
+    bool haveNameIndex(void) const { return _have_name_index; }
+
+    /**
+     * Return all nodes of the given type whose name starts with
+     * `prefix`, or contains `sub`.  These use the name index, if
+     * there is one, and otherwise walk over all nodes of that type.
+     */
+    HandleSeq getNodesByPrefix(Type, const std::string& prefix,
+                               bool parent=true) const;
+    HandleSeq getNodesBySubstring(Type, const std::string& sub,
+                                  bool parent=true) const;
+
+    /**
+     * Return all nodes, of any type, with the given name. Types that
+     * have a name index are probed; all others are walked over.
+     */
+    HandleSeq getNodesByName(const std::string& name,
+                             bool parent=true) const;
+
+    /**
+     * Give every atom in this table a small integer id. The ids are
+     * dense: they run from zero up to getAtomIdBound(), with few gaps,
+     * as the ids of extracted atoms are reused. Atoms added later get
+     * an id as they are added. Graph algorithms can then use the ids
+     * to index plain arrays, instead of hashing Handles.
+     *
+     * Only the atoms in this table get ids; those in the parent
+     * environment (if any) do not.
+     */
+    void enableAtomIds(void);
+
+    /** Stop handing out ids; the atoms lose the ids they have. */
+    void disableAtomIds(void);
+
+    bool haveAtomIds(void) const { return _have_atom_ids; }
+
+    /**
+     * Return the id of the atom, or INVALID_ATOM_ID if the atom is
+     * not in this table, or if this table does not hand out ids.
+     */
+    AtomId getAtomId(const Handle& h) const
+    {
+        if (not _have_atom_ids or nullptr == h or
+            h->getAtomSpace() != _as) return INVALID_ATOM_ID;
+        return h->_atom_id;
+    }
+
+    /** Return the atom with the given id, or Handle::UNDEFINED. */
+    Handle getAtomById(AtomId) const;
+
+    /** Same as getAtomById(), for many ids, under one lock. */
+    HandleSeq getAtomsById(const std::vector<AtomId>&) const;
+
+    /** All ids are less than this; zero if there are no ids. */
+    size_t getAtomIdBound(void) const;
+
+    /**
+     * Export the graph formed by the atoms of the given types (and
+     * their subtypes, if `subclass` is set) as compressed sparse rows;
+     * see AtomCSR. Does not turn on atom ids.
+     */
+    void exportCSR(AtomCSR&, const TypeSet&, bool subclass=true);
+
+    /**
+     * Open a batch of updates. Until the matching commitBatch(), the
+     * atoms that this thread adds to, or extracts from, this table
+     * are buffered, and are applied only at commit, all at once,
+     * under one short lock. Other threads do not see them until then,
+     * and are not blocked meanwhile. The add, remove and TV-changed
+     * signals for the changes made by this thread are held back, and
+     * are sent, in the order the changes happened, once they are
+     * applied; then a single batch signal is sent, listing all of the
+     * changes.
+     *
+     * While the batch is open, this thread sees its own changes when
+     * it looks up single atoms: added atoms are found, and extracted
+     * ones are not. Everything else, e.g. getHandlesByType(), incoming
+     * sets, and the results of extracting atoms, reflects the table
+     * as it is, until the commit. Extracting an atom with a non-empty
+     * incoming set can still fail at commit. Values, including truth
+     * values, are not buffered; they are set right away, and an atom
+     * added in the batch carries the values set on it meanwhile. If
+     * another thread adds an equal atom before the commit, that one
+     * is kept, and it gets the values.
+     *
+     * Changes made by other threads are not part of the batch, and
+     * are signalled right away, as usual. Batches can be nested; only
+     * the outermost commit has any effect. Both calls must be made
+     * from the same thread. Prefer the scoped AtomBatch (in
+     * AtomSpace.h), which commits even if an exception is thrown.
+     *
+     * Note that removal signals are sent after the atom has already
+     * been removed, and not before, as is the case outside of a batch.
+     */
+    void beginBatch(void);
+    void commitBatch(void);
+    bool inBatch(void) const { return nullptr != findBatch(); }
+
+    /**
+     * Called by Atom::setTruthValue() whenever a TV changes. Inlined,
+     * for the same reason as in_environ() above.
+     */
+    void tvChanged(const Handle& atom, const TruthValuePtr& oldtv,
+                   const TruthValuePtr& newtv)
+    {
+        Batch* b = findBatch();
+        if (b) {
+            b->log.push_back({BatchEvent::TV_CHANGED, atom, oldtv, newtv});
+            return;
+        }
+        _TVChangedSignal.emit(atom, oldtv, newtv);
+    }
+
     AtomSignal& atomAddedSignal() { return _addAtomSignal; }
     AtomSignal& atomRemovedSignal() { return _removeAtomSignal; }
 
     /** Provide ability for others to find out about TV changes */
     TVCHSigl& TVChangedSignal() { return _TVChangedSignal; }
+
+    /** Provide ability for others to find out about whole batches */
+    AtomBatchSignal& atomBatchSignal() { return _batchSignal; }
 };
 
 /** @}*/
@@ -37,3 +37,10 @@ void BackingStore::unregisterWith(AtomSpace* atomspace)
 {
 	atomspace->unregisterBackingStore(this);
 }
+
+void BackingStore::storeBatch(const HandleSeq& hseq, bool synchronous)
+{
+	for (const Handle& h : hseq)
+		storeAtom(h);
+	if (synchronous) barrier();
+}
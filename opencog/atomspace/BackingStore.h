@@ -87,6 +87,25 @@ class BackingStore
 		 */
 		virtual void storeAtom(const Handle&, bool synchronous = false) = 0;
 
+		/**
+		 * Store a group of Atoms, e.g. all of the Atoms touched by one
+		 * AtomTable batch. The default just calls storeAtom() on each
+		 * of them; backends that can write many rows in one round-trip
+		 * should override this. If `synchronous` is set, this does not
+		 * return until all of the atoms have been stored. Committing a
+		 * batch calls this only if storeOnCommit() says so.
+		 */
+		virtual void storeBatch(const HandleSeq&, bool synchronous = false);
+
+		/**
+		 * Return true to have storeBatch() called with the Atoms added,
+		 * and those whose TruthValue changed, by each batch committed
+		 * in the AtomSpace this is registered with. It is called in the
+		 * committing thread, after the batch signal handlers. The
+		 * default is false: changes are stored only when asked to.
+		 */
+		virtual bool storeOnCommit(void) const { return false; }
+
 		/**
 		 * Remove the indicated Atom from the backing store.
 		 * If the recursive flag is set, then incoming set of the Atom
@@ -0,0 +1,295 @@
+/*
+ * opencog/atomspace/FlatAtomSet.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_FLATATOMSET_H
+#define _OPENCOG_FLATATOMSET_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A hash multiset of atoms, keyed by their ContentHash, kept in one
+ * flat, open-addressing table. The hash and the Handle are stored
+ * inline, in the table itself, instead of in a separately allocated
+ * node per atom, as std::unordered_multimap does.
+ *
+ * The table is split into groups of 16 slots. Each slot has a control
+ * byte, holding seven bits of the hash of the atom in that slot (or
+ * marking the slot as empty or deleted). A lookup compares the control
+ * bytes of a whole group at once (with one SSE2 compare, if available),
+ * and only looks at the slots whose seven bits match. A lookup stops
+ * at the first group that has an empty slot.
+ *
+ * This offers the subset of the std::unordered_multimap interface that
+ * the TypeIndex uses; the "buckets" are the groups. Like the multimap,
+ * inserting may move all of the entries, and so invalidates iterators.
+ * Erasing does not move anything.
+ */
+class FlatAtomSet
+{
+	public:
+		typedef std::pair<ContentHash, Handle> value_type;
+
+	private:
+		static const size_t GROUP = 16;
+		static const int8_t EMPTY = -128;
+		static const int8_t DELETED = -2;
+
+		std::vector<int8_t> _ctrl;
+		std::vector<value_type> _slots;
+		size_t _size;
+		size_t _deleted;
+
+		// The content hash is good, but the MSB only tells nodes from
+		// links; so spread the bits once more, before splitting them.
+		static uint64_t spread(ContentHash h)
+		{
+			return ((uint64_t) h) * 0x9e3779b97f4a7c15ull;
+		}
+		static int8_t h2(uint64_t s) { return (int8_t) (s >> 57); }
+		size_t ngroups(void) const { return _ctrl.size() / GROUP; }
+		size_t first_group(uint64_t s) const
+		{
+			return (s >> 7) & (ngroups() - 1);
+		}
+
+		// Bitmask of the slots of group `g` whose control byte is `c`.
+		uint32_t match(size_t g, int8_t c) const
+		{
+			const int8_t* p = &_ctrl[g * GROUP];
+#ifdef __SSE2__
+			__m128i ctl = _mm_loadu_si128((const __m128i*) p);
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(ctl, _mm_set1_epi8(c)));
+#else
+			uint32_t m = 0;
+			for (size_t i = 0; i < GROUP; i++)
+				if (c == p[i]) m |= 1u << i;
+			return m;
+#endif
+		}
+
+		// Bitmask of the slots of group `g` that are free to be filled.
+		uint32_t match_free(size_t g) const
+		{
+			const int8_t* p = &_ctrl[g * GROUP];
+#ifdef __SSE2__
+			// Both EMPTY and DELETED are negative; full slots are not.
+			__m128i ctl = _mm_loadu_si128((const __m128i*) p);
+			return _mm_movemask_epi8(ctl);
+#else
+			uint32_t m = 0;
+			for (size_t i = 0; i < GROUP; i++)
+				if (p[i] < 0) m |= 1u << i;
+			return m;
+#endif
+		}
+
+		static unsigned lowest(uint32_t m) { return __builtin_ctz(m); }
+
+		// Put the entry into the first free slot on its probe path.
+		// The table must have room. Returns true if a deleted slot
+		// was reused.
+		bool place(value_type&& v)
+		{
+			uint64_t s = spread(v.first);
+			size_t mask = ngroups() - 1;
+			size_t g = first_group(s);
+			for (size_t step = 1; ; step++)
+			{
+				uint32_t m = match_free(g);
+				if (m)
+				{
+					size_t i = g * GROUP + lowest(m);
+					bool reused = (DELETED == _ctrl[i]);
+					_ctrl[i] = h2(s);
+					_slots[i] = std::move(v);
+					return reused;
+				}
+				g = (g + step) & mask;
+			}
+		}
+
+		void rehash(size_t nslots)
+		{
+			std::vector<int8_t> ctrl(nslots, (int8_t) EMPTY);
+			std::vector<value_type> slots(nslots);
+			ctrl.swap(_ctrl);
+			slots.swap(_slots);
+			_deleted = 0;
+			for (size_t i = 0; i < ctrl.size(); i++)
+				if (0 <= ctrl[i]) place(std::move(slots[i]));
+		}
+
+		// Make room for one more entry; keep the load under 7/8.
+		void reserve_one(void)
+		{
+			size_t cap = _ctrl.size();
+			if ((_size + _deleted + 1) * 8 <= cap * 7) return;
+
+			// If it is mostly tombstones, then just clean them out.
+			if (0 < cap and (_size + 1) * 16 <= cap * 7)
+				rehash(cap);
+			else
+				rehash(0 == cap ? GROUP : 2 * cap);
+		}
+
+		// Index of the first full slot at or after `i`.
+		size_t skip(size_t i) const
+		{
+			while (i < _ctrl.size() and _ctrl[i] < 0) i++;
+			return i;
+		}
+
+	public:
+		FlatAtomSet(void) : _size(0), _deleted(0) {}
+
+		class const_iterator
+		{
+			friend class FlatAtomSet;
+			const FlatAtomSet* _set;
+			size_t _i;
+			const_iterator(const FlatAtomSet* s, size_t i) : _set(s), _i(i) {}
+			public:
+				const_iterator(void) : _set(nullptr), _i(0) {}
+				const value_type& operator*(void) const
+					{ return _set->_slots[_i]; }
+				const value_type* operator->(void) const
+					{ return &_set->_slots[_i]; }
+				const_iterator& operator++(void)
+				{
+					_i = _set->skip(_i + 1);
+					return *this;
+				}
+				const_iterator operator++(int)
+				{
+					const_iterator it(*this);
+					++(*this);
+					return it;
+				}
+				bool operator==(const const_iterator& o) const
+					{ return _i == o._i; }
+				bool operator!=(const const_iterator& o) const
+					{ return _i != o._i; }
+		};
+		typedef const_iterator iterator;
+
+		const_iterator begin(void) const { return const_iterator(this, skip(0)); }
+		const_iterator end(void) const { return const_iterator(this, _ctrl.size()); }
+
+		/// The groups serve as buckets, so that the table can be split
+		/// into parts without copying it first.
+		size_t bucket_count(void) const { return ngroups(); }
+		const_iterator begin(size_t b) const
+		{
+			return const_iterator(this, skip(b * GROUP));
+		}
+		const_iterator end(size_t b) const
+		{
+			return const_iterator(this, skip((b + 1) * GROUP));
+		}
+
+		size_t size(void) const { return _size; }
+		bool empty(void) const { return 0 == _size; }
+
+		/// Bytes used by the table, not counting the atoms themselves.
+		size_t memory_usage(void) const
+		{
+			return _ctrl.capacity() * sizeof(int8_t) +
+			       _slots.capacity() * sizeof(value_type);
+		}
+
+		void clear(void)
+		{
+			std::vector<int8_t>().swap(_ctrl);
+			std::vector<value_type>().swap(_slots);
+			_size = 0;
+			_deleted = 0;
+		}
+
+		/// Add the entry. Entries with equal hashes are allowed, just
+		/// as in a multimap.
+		void insert(value_type&& v)
+		{
+			reserve_one();
+			if (place(std::move(v))) _deleted--;
+			_size++;
+		}
+		void insert(const value_type& v) { insert(value_type(v)); }
+
+		/// Return the entry with hash `hsh` for which `pred(handle)` is
+		/// true, or end(), if there is none.
+		template <typename Pred>
+		const_iterator find_if(ContentHash hsh, Pred pred) const
+		{
+			if (0 == _size) return end();
+
+			uint64_t s = spread(hsh);
+			int8_t tag = h2(s);
+			size_t mask = ngroups() - 1;
+			size_t g = first_group(s);
+			for (size_t step = 1; step <= ngroups(); step++)
+			{
+				for (uint32_t m = match(g, tag); m; m &= m - 1)
+				{
+					size_t i = g * GROUP + lowest(m);
+					if (_slots[i].first == hsh and pred(_slots[i].second))
+						return const_iterator(this, i);
+				}
+				if (match(g, EMPTY)) break;
+				g = (g + step) & mask;
+			}
+			return end();
+		}
+
+		void erase(const_iterator it)
+		{
+			_ctrl[it._i] = DELETED;
+			_slots[it._i] = value_type();
+			_size--;
+			_deleted++;
+		}
+};
+
+/// Find the entry with hash `hsh` for which `pred(handle)` is true.
+template <typename Pred>
+FlatAtomSet::const_iterator find_entry(const FlatAtomSet& s,
+                                       ContentHash hsh, Pred pred)
+{
+	return s.find_if(hsh, pred);
+}
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_FLATATOMSET_H
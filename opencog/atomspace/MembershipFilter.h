@@ -0,0 +1,111 @@
+/*
+ * opencog/atomspace/MembershipFilter.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_MEMBERSHIPFILTER_H
+#define _OPENCOG_MEMBERSHIPFILTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A Bloom filter over the content hashes of the atoms in one
+ * AtomTable. It answers "might this table hold an atom with this
+ * hash?" without taking any lock, so that a lookup that misses in a
+ * table does not have to lock it.
+ *
+ * Bits are only ever set; extracting an atom leaves its bits behind,
+ * which merely makes the filter a little less sharp. Bits are set
+ * before the atom is put into the table's index, so a reader that
+ * finds a bit clear knows that the atom was not yet there.
+ *
+ * Writers must hold the table lock. The filter has a fixed size; the
+ * table replaces it by a larger one once full() returns true.
+ */
+class MembershipFilter
+{
+	private:
+		typedef std::atomic<uint64_t> Word;
+
+		std::unique_ptr<Word[]> _bits;
+		size_t _mask;     // Number of bits, less one.
+		size_t _count;    // Number of inserts; guarded by the table lock.
+
+		// Two bit positions, from the two halves of the hash, after
+		// one round of mixing, as the content hash is not uniform
+		// in its low bits.
+		static uint64_t mix(ContentHash h)
+		{
+			uint64_t x = h;
+			x ^= x >> 33;
+			x *= 0xff51afd7ed558ccdULL;
+			x ^= x >> 33;
+			return x;
+		}
+
+	public:
+		/// `nbits` must be a power of two, and at least 64.
+		MembershipFilter(size_t nbits) :
+			_bits(new Word[nbits / 64]), _mask(nbits - 1), _count(0)
+		{
+			for (size_t i = 0; i < nbits / 64; i++)
+				_bits[i].store(0, std::memory_order_relaxed);
+		}
+
+		size_t num_bits(void) const { return _mask + 1; }
+		bool empty(void) const { return 0 == _count; }
+
+		/// True once the false-positive rate would get too high; at
+		/// eight bits per atom and two probes, it is about 5%.
+		bool full(void) const { return num_bits() < 8 * _count; }
+
+		void insert(ContentHash h)
+		{
+			uint64_t x = mix(h);
+			size_t a = x & _mask;
+			size_t b = (x >> 32) & _mask;
+			_bits[a / 64].fetch_or(1ULL << (a % 64));
+			_bits[b / 64].fetch_or(1ULL << (b % 64));
+			_count++;
+		}
+
+		bool may_contain(ContentHash h) const
+		{
+			uint64_t x = mix(h);
+			size_t a = x & _mask;
+			size_t b = (x >> 32) & _mask;
+			return (_bits[a / 64].load() & (1ULL << (a % 64))) and
+			       (_bits[b / 64].load() & (1ULL << (b % 64)));
+		}
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_MEMBERSHIPFILTER_H
@@ -0,0 +1,128 @@
+/*
+ * opencog/atomspace/NameIndex.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_NAMEINDEX_H
+#define _OPENCOG_NAMEINDEX_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A sorted index of the Nodes of one given type, ordered by name.
+ * This allows all nodes whose name starts with a given prefix, e.g.
+ * all WordNodes starting with "anti", to be found without visiting
+ * every node of that type.
+ *
+ * Node names never change, so the index only needs to be updated
+ * when nodes are added to or extracted from the AtomTable.
+ */
+class NameIndex
+{
+	private:
+		typedef std::map<std::string, Handle> NameMap;
+
+		Type _type;
+
+		mutable std::mutex _mtx;
+		NameMap _by_name;
+
+	public:
+		NameIndex(Type t) : _type(t) {}
+
+		Type get_type(void) const { return _type; }
+
+		void insert(const Handle& h)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			_by_name.emplace(h->get_name(), h);
+		}
+
+		void remove(const Handle& h)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			auto it = _by_name.find(h->get_name());
+			if (_by_name.end() != it and it->second == h)
+				_by_name.erase(it);
+		}
+
+		void clear(void)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			_by_name.clear();
+		}
+
+		size_t size(void) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			return _by_name.size();
+		}
+
+		/// Return the node with exactly this name, else Handle::UNDEFINED.
+		Handle get_exact(const std::string& name) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			auto it = _by_name.find(name);
+			if (_by_name.end() == it) return Handle::UNDEFINED;
+			return it->second;
+		}
+
+		/// Append all nodes whose name starts with `prefix`, in
+		/// lexicographic order.
+		void get_prefix(HandleSeq& hs, const std::string& prefix) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			auto it = _by_name.lower_bound(prefix);
+			for (; it != _by_name.end(); it++)
+			{
+				if (0 != it->first.compare(0, prefix.size(), prefix)) break;
+				hs.emplace_back(it->second);
+			}
+		}
+
+		/// Append all nodes whose name contains `sub`. This visits
+		/// every entry in the index; it is still cheaper than walking
+		/// the type bucket, as no atoms are dereferenced.
+		void get_substring(HandleSeq& hs, const std::string& sub) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			for (const auto& pr : _by_name)
+				if (std::string::npos != pr.first.find(sub))
+					hs.emplace_back(pr.second);
+		}
+};
+
+typedef std::shared_ptr<NameIndex> NameIndexPtr;
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_NAMEINDEX_H
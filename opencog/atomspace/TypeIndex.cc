@@ -56,6 +56,39 @@ bool TypeIndex::contains_duplicate(const AtomSet& atoms) const
 
 // ================================================================
 
+void TypeIndex::partition(std::vector<HandleSeq>& parts, Type type,
+                          bool subclass, size_t part_size) const
+{
+	if (0 == part_size) part_size = 1;
+	if (parts.empty()) parts.emplace_back();
+
+	// A subclass of t is NEVER smaller than t.
+	for (Type t = type; t < _num_types; t++)
+	{
+		if (t != type and not (subclass and nameserver().isA(t, type)))
+			continue;
+
+		const AtomSet& s(_idx[t]);
+		if (s.empty()) continue;
+
+		size_t nbkts = s.bucket_count();
+		for (size_t b = 0; b < nbkts; b++)
+		{
+			if (part_size <= parts.back().size())
+				parts.emplace_back();
+
+			HandleSeq& part(parts.back());
+			auto end = s.end(b);
+			for (auto it = s.begin(b); it != end; it++)
+				part.emplace_back(it->second);
+		}
+	}
+
+	if (parts.back().empty()) parts.pop_back();
+}
+
+// ================================================================
+
 TypeIndex::iterator TypeIndex::begin(Type t, bool sub) const
 {
 	iterator it(t, sub);
@@ -28,6 +28,7 @@
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/atom_types/types.h>
+#include <opencog/atomspace/FlatAtomSet.h>
 
 class AtomSpaceUTest;
 
@@ -37,7 +38,7 @@ namespace opencog
  *  @{
  */
 
-typedef std::unordered_multimap<ContentHash, Handle> AtomSet;
+typedef FlatAtomSet AtomSet;
 
 /**
  * Implements a vector of AtomSets; each AtomSet is a hash table of
@@ -71,28 +72,50 @@ class TypeIndex
 		void removeAtom(const Handle& h)
 		{
 			AtomSet& s(_idx.at(h->get_type()));
-			auto range = s.equal_range(h->get_hash());
-			auto bkt = range.first;
-			auto end = range.second;
-			for (; bkt != end; bkt++) {
-				if (*h == *bkt->second) {
-					s.erase(bkt);
-					break;
-				}
-			}
+			auto bkt = find_entry(s, h->get_hash(),
+				[&](const Handle& o) { return *h == *o; });
+			if (s.end() != bkt) s.erase(bkt);
 		}
 
 		Handle findAtom(const Handle& h) const
 		{
 			const AtomSet& s(_idx.at(h->get_type()));
-			auto range = s.equal_range(h->get_hash());
-			auto bkt = range.first;
-			auto end = range.second;
-			for (; bkt != end; bkt++) {
-				if (*h == *bkt->second) /* content-compare */
-					return bkt->second;
-			}
-			return Handle::UNDEFINED;
+			auto bkt = find_entry(s, h->get_hash(),
+				[&](const Handle& o) { return *h == *o; /* content-compare */ });
+			if (s.end() == bkt) return Handle::UNDEFINED;
+			return bkt->second;
+		}
+
+		/// Find the node with the given name, without constructing
+		/// one first. The hash must be that of a plain Node.
+		Handle findNode(Type t, const std::string& name,
+		                ContentHash hsh) const
+		{
+			const AtomSet& s(_idx.at(t));
+			auto bkt = find_entry(s, hsh,
+				[&](const Handle& o) { return name == o->get_name(); });
+			if (s.end() == bkt) return Handle::UNDEFINED;
+			return bkt->second;
+		}
+
+		/// Find the link with the given outgoing set, without
+		/// constructing one first. The hash must be that of a plain
+		/// Link.
+		Handle findLink(Type t, const HandleSeq& oset,
+		                ContentHash hsh) const
+		{
+			const AtomSet& s(_idx.at(t));
+			auto bkt = find_entry(s, hsh, [&](const Handle& o)
+			{
+				const HandleSeq& out(o->getOutgoingSet());
+				if (out.size() != oset.size()) return false;
+
+				for (size_t i = 0; i < out.size(); i++)
+					if (*out[i] != *oset[i]) return false; /* content-compare */
+				return true;
+			});
+			if (s.end() == bkt) return Handle::UNDEFINED;
+			return bkt->second;
 		}
 
 		size_t size(Type t) const
@@ -113,9 +136,9 @@ class TypeIndex
 		{
 			for (auto& s : _idx)
 			{
-				for (auto& pr : s)
+				for (const auto& pr : s)
 				{
-					Handle& atom_to_clear = pr.second;
+					const Handle& atom_to_clear = pr.second;
 					atom_to_clear->_atom_space = nullptr;
 
 					// We installed the incoming set; we remove it too.
@@ -125,6 +148,13 @@ class TypeIndex
 			}
 		}
 
+		/// Copy the atoms of the given type (and subtypes, if asked)
+		/// into `parts`, roughly `part_size` atoms per part. Parts are
+		/// cut only between hash buckets, so that each part is a run
+		/// of whole buckets of one or more types.
+		void partition(std::vector<HandleSeq>& parts, Type, bool subclass,
+		               size_t part_size) const;
+
 		// Return true if there exists some index containing duplicated
 		// atoms (equal by content). Used during unit tests.
 		bool contains_duplicate() const;
@@ -0,0 +1,352 @@
+/*
+ * opencog/atomspace/ValueColumn.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_VALUECOLUMN_H
+#define _OPENCOG_VALUECOLUMN_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/FloatValue.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class ValueColumn;
+
+/**
+ * A FloatValue that is a row of a ValueColumn. It does not copy the
+ * row when it is made, but only when its numbers are first asked for.
+ * Before the row is changed or removed, the column copies it into the
+ * view, if it has not been copied yet; thus a view, like any other
+ * value, never changes.
+ */
+class ColumnValue
+	: public FloatValue
+{
+	friend class ValueColumn;
+
+	private:
+		std::shared_ptr<const ValueColumn> _col;
+		mutable size_t _row;      // Guarded by the column lock.
+		mutable std::atomic_bool _filled;
+
+		// Caller must hold the column lock.
+		void fill(const double* row, size_t width) const
+		{
+			_value.assign(row, row + width);
+			_filled.store(true, std::memory_order_release);
+		}
+
+	protected:
+		virtual void update() const;
+
+	public:
+		ColumnValue(const std::shared_ptr<const ValueColumn>& col, size_t row) :
+			FloatValue(FLOAT_VALUE), _col(col), _row(row), _filled(false) {}
+};
+
+/**
+ * Columnar storage for the FloatValues, all of the same length, that
+ * the atoms of one given type hold at one given key. Instead of a
+ * separate FloatValue per atom, the numbers are kept in one dense,
+ * row-major matrix, with one row per atom. This saves several heap
+ * objects per atom, and lets batch operations, such as dot(), run
+ * over contiguous memory.
+ *
+ * Only FloatValues of exactly the column width are stored here; any
+ * other value at the key is kept on the atom, as usual. Reading the
+ * value back gives a ColumnValue, a view of the row, so that the
+ * column is invisible to code that uses Atom::getValue(). The same
+ * view is handed out until the row changes.
+ *
+ * The rows are found by atom id, and so the table must hand out ids
+ * while it has columns; see AtomTable::enableAtomIds().
+ *
+ * The column is used by Atom::setValue() and Atom::getValue(); it is
+ * kept in the header so that it gets inlined into Atom.cc, and thus
+ * avoids a circular dependency between the atombase and atomspace
+ * shared libraries. (Same reason as for ValueIndex.)
+ */
+class ValueColumn
+	: public std::enable_shared_from_this<ValueColumn>
+{
+	friend class ColumnValue;
+
+	private:
+		static const uint32_t NO_ROW = UINT32_MAX;
+
+		Type _type;
+		Handle _key;
+		size_t _width;
+
+		mutable std::mutex _mtx;
+		std::vector<double> _data;
+		HandleSeq _atoms;                 // The atom of each row.
+		std::vector<uint32_t> _rows;      // The row of each atom id.
+
+		// The view last handed out for each row, if any.
+		mutable std::vector<std::weak_ptr<ColumnValue>> _views;
+
+		// Caller must hold _mtx. Return the row of the atom, or NO_ROW.
+		// The atom in the row is checked too, as ids are reused.
+		size_t row_of(const Atom* a) const
+		{
+			AtomId id = a->_atom_id;
+			if (_rows.size() <= id) return NO_ROW;
+			size_t row = _rows[id];
+			if (NO_ROW == row or _atoms[row].operator->() != a)
+				return NO_ROW;
+			return row;
+		}
+
+		// Caller must hold _mtx. The row is about to change, or go away;
+		// copy it into its view, if it has one, and forget the view.
+		void detach(size_t row)
+		{
+			std::shared_ptr<ColumnValue> view(_views[row].lock());
+			if (view and not view->_filled.load(std::memory_order_relaxed))
+				view->fill(&_data[row * _width], _width);
+			_views[row].reset();
+		}
+
+		// Caller must hold _mtx.
+		void drop(size_t row)
+		{
+			detach(row);
+
+			// Move the last row into the hole.
+			size_t last = _atoms.size() - 1;
+			AtomId id = _atoms[row]->_atom_id;
+			if (id < _rows.size() and row == _rows[id])
+				_rows[id] = NO_ROW;
+			if (row != last)
+			{
+				std::copy(_data.begin() + last * _width,
+				          _data.begin() + (last+1) * _width,
+				          _data.begin() + row * _width);
+				_atoms[row] = std::move(_atoms[last]);
+				_views[row] = std::move(_views[last]);
+				std::shared_ptr<ColumnValue> view(_views[row].lock());
+				if (view) view->_row = row;
+				AtomId lid = _atoms[row]->_atom_id;
+				if (lid < _rows.size() and last == _rows[lid])
+					_rows[lid] = row;
+			}
+			_atoms.pop_back();
+			_views.pop_back();
+			_data.resize(last * _width);
+		}
+
+		// Caller must hold _mtx.
+		ValuePtr view_of(size_t row) const
+		{
+			std::shared_ptr<ColumnValue> view(_views[row].lock());
+			if (nullptr == view)
+			{
+				view = std::shared_ptr<ColumnValue>(
+					new ColumnValue(shared_from_this(), row));
+				_views[row] = view;
+			}
+			return view;
+		}
+
+	public:
+		ValueColumn(Type t, const Handle& key, size_t width) :
+			_type(t), _key(key), _width(width) {}
+
+		Type get_type(void) const { return _type; }
+		const Handle& get_key(void) const { return _key; }
+		size_t get_width(void) const { return _width; }
+
+		/// Return true if this column holds the values at `key` on
+		/// atoms of type `t`.
+		bool covers(Type t, const Handle& key) const
+		{
+			return t == _type and (key == _key or *key == *_key);
+		}
+
+		/// Return true if the value can be stored in the column.
+		bool fits(const ValuePtr& v) const
+		{
+			return nullptr != v and FLOAT_VALUE == v->get_type() and
+				FloatValueCast(v)->size() == _width;
+		}
+
+		/// Store the value as the row of the atom. Returns false, and
+		/// does nothing, if the value does not fit, or if the atom has
+		/// no id.
+		bool store(const Handle& h, const ValuePtr& v)
+		{
+			if (not fits(v)) return false;
+			AtomId id = h->_atom_id;
+			if (INVALID_ATOM_ID == id) return false;
+			const std::vector<double>& fv = FloatValueCast(v)->value();
+
+			std::lock_guard<std::mutex> lck(_mtx);
+			size_t row = row_of(h.operator->());
+			if (NO_ROW != row)
+				detach(row);
+			else
+			{
+				if (_rows.size() <= id) _rows.resize(id + 1, (uint32_t) NO_ROW);
+				if (NO_ROW != _rows[id]) drop(_rows[id]);
+				row = _atoms.size();
+				_rows[id] = row;
+				_atoms.emplace_back(h);
+				_views.emplace_back();
+				_data.resize((row+1) * _width);
+			}
+			std::copy(fv.begin(), fv.end(), _data.begin() + row * _width);
+			return true;
+		}
+
+		/// Return a view of the row of the atom, or nullptr if the
+		/// atom has no row.
+		ValuePtr fetch(const Atom* a) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			size_t row = row_of(a);
+			if (NO_ROW == row) return nullptr;
+			return view_of(row);
+		}
+
+		bool holds(const Atom* a) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			return NO_ROW != row_of(a);
+		}
+
+		/// Remove the row of the atom, returning the value that it
+		/// held, or nullptr, if the atom had no row.
+		ValuePtr take(const Handle& h)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			size_t row = row_of(h.operator->());
+			if (NO_ROW == row) return nullptr;
+			ValuePtr v(view_of(row));
+			drop(row);
+			return v;
+		}
+
+		void remove(const Handle& h)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			size_t row = row_of(h.operator->());
+			if (NO_ROW != row) drop(row);
+		}
+
+		void clear(void)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			for (size_t r = 0; r < _atoms.size(); r++)
+				detach(r);
+			_data.clear();
+			_atoms.clear();
+			_rows.clear();
+			_views.clear();
+		}
+
+		size_t size(void) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			return _atoms.size();
+		}
+
+		/// Call `func(const Handle&, const double* row)` on every row.
+		/// The column is locked while this runs; `func` must not set
+		/// values at this key.
+		template <typename Function>
+		void foreach_row(Function func) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			for (size_t r = 0; r < _atoms.size(); r++)
+				func(_atoms[r], &_data[r * _width]);
+		}
+
+		/// Copy out the whole column: the atoms, and the matrix of
+		/// their rows, in the same order.
+		void get_matrix(HandleSeq& atoms, std::vector<double>& data) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			atoms = _atoms;
+			data = _data;
+		}
+
+		/// Take the dot product of every row with `vec`, which must be
+		/// as long as the column is wide. The results are returned in
+		/// `prods`, in the same order as the atoms in `atoms`.
+		void dot(const std::vector<double>& vec,
+		         HandleSeq& atoms, std::vector<double>& prods) const
+		{
+			if (vec.size() != _width)
+				throw RuntimeException(TRACE_INFO,
+					"Expecting a vector of length %zu, got %zu",
+					_width, vec.size());
+
+			std::lock_guard<std::mutex> lck(_mtx);
+			atoms = _atoms;
+			prods.resize(_atoms.size());
+			const double* v = vec.data();
+			for (size_t r = 0; r < _atoms.size(); r++)
+			{
+				// Four independent sums, so that the loop does not
+				// wait on a single accumulator, and can be vectorized.
+				const double* p = &_data[r * _width];
+				double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+				size_t i = 0;
+				for (; i + 4 <= _width; i += 4)
+				{
+					s0 += p[i] * v[i];
+					s1 += p[i+1] * v[i+1];
+					s2 += p[i+2] * v[i+2];
+					s3 += p[i+3] * v[i+3];
+				}
+				for (; i < _width; i++) s0 += p[i] * v[i];
+				prods[r] = (s0 + s1) + (s2 + s3);
+			}
+		}
+};
+
+typedef std::shared_ptr<ValueColumn> ValueColumnPtr;
+
+inline void ColumnValue::update() const
+{
+	if (_filled.load(std::memory_order_acquire)) return;
+	std::lock_guard<std::mutex> lck(_col->_mtx);
+	if (_filled.load(std::memory_order_relaxed)) return;
+	fill(&_col->_data[_row * _col->_width], _col->_width);
+}
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_VALUECOLUMN_H
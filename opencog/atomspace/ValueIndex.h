@@ -0,0 +1,227 @@
+/*
+ * opencog/atomspace/ValueIndex.h
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_VALUEINDEX_H
+#define _OPENCOG_VALUEINDEX_H
+
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/value/FloatValue.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * A sorted index of the atoms of one given type, ordered by one of
+ * the numbers held in the FloatValue (or NumberNode) at one given key.
+ * This allows range queries, e.g. "all EvaluationLinks whose count is
+ * more than 100", to be answered without visiting every atom of that
+ * type.
+ *
+ * The numbers are those that ValueOfLink hands to the arithmetic
+ * links, so that a GreaterThanLink sees the same number as the index.
+ * Atoms that do not have a number at the key, or have too few, are
+ * not in the index.
+ *
+ * The index is updated by Atom::setValue(); it is kept in the header
+ * so that it gets inlined into Atom.cc, and thus avoids a circular
+ * dependency between the atombase and atomspace shared libraries.
+ * (Same reason as for AtomTable::in_environ().)
+ */
+class ValueIndex
+{
+	private:
+		typedef std::multimap<double, Handle> ValueMap;
+
+		Type _type;
+		Handle _key;
+		size_t _slot;
+
+		mutable std::mutex _mtx;
+		ValueMap _by_value;
+		std::unordered_map<Handle, ValueMap::iterator> _where;
+
+		/// Get the number at `_slot` in the name of a NumberNode. The
+		/// name is a list of numbers, separated by spaces; it is parsed
+		/// here, rather than with NumberNode::to_vector(), because
+		/// NumberNode lives in a library that links against this one.
+		bool get_node_number(const Handle& h, double& d) const
+		{
+			const char* p = h->get_name().c_str();
+			for (size_t i = 0; ; i++)
+			{
+				char* end;
+				double x = strtod(p, &end);
+				if (end == p) return false;
+				if (i == _slot) { d = x; return true; }
+				p = end;
+			}
+		}
+
+		/// Get the indexed number held by the atom. Return false if
+		/// there isn't one.
+		bool get_number(const Handle& h, double& d) const
+		{
+			ValuePtr vp(h->getValue(_key));
+			if (nullptr == vp) return false;
+
+			if (NUMBER_NODE == vp->get_type())
+			{
+				if (not get_node_number(HandleCast(vp), d)) return false;
+				return not std::isnan(d);
+			}
+
+			if (not nameserver().isA(vp->get_type(), FLOAT_VALUE))
+				return false;
+
+			const std::vector<double>& v = FloatValueCast(vp)->value();
+			if (v.size() <= _slot) return false;
+			d = v[_slot];
+
+			// NaN does not sort; such atoms are simply not indexed.
+			return not std::isnan(d);
+		}
+
+		void drop(const Handle& h)
+		{
+			auto it = _where.find(h);
+			if (_where.end() == it) return;
+			_by_value.erase(it->second);
+			_where.erase(it);
+		}
+
+	public:
+		ValueIndex(Type t, const Handle& key, size_t slot) :
+			_type(t), _key(key), _slot(slot) {}
+
+		Type get_type(void) const { return _type; }
+		const Handle& get_key(void) const { return _key; }
+		size_t get_slot(void) const { return _slot; }
+
+		bool is_index_for(Type t, const Handle& key, size_t slot) const
+		{
+			return t == _type and slot == _slot and
+				(key == _key or *key == *_key);
+		}
+
+		/// Return true if setting the value at `key` on an atom of
+		/// type `t` might change this index.
+		bool covers(Type t, const Handle& key) const
+		{
+			return t == _type and (key == _key or *key == *_key);
+		}
+
+		/// (Re-)index the atom, using whatever value it holds right
+		/// now. The value is re-read under the index lock, so that
+		/// racing setters always leave the most recent value indexed.
+		/// Atoms that have already left the atomspace are dropped;
+		/// AtomTable::extract() removes an atom from the index only
+		/// after that, so a racing setter cannot put it back.
+		void update(const Handle& h)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			drop(h);
+			if (nullptr == h->getAtomSpace()) return;
+			double d;
+			if (not get_number(h, d)) return;
+			_where[h] = _by_value.insert({d, h});
+		}
+
+		void remove(const Handle& h)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			drop(h);
+		}
+
+		void clear(void)
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			_by_value.clear();
+			_where.clear();
+		}
+
+		size_t size(void) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			return _by_value.size();
+		}
+
+		/// Append all atoms whose number is strictly greater than `lo`.
+		void get_greater(HandleSeq& hs, double lo) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			auto it = _by_value.upper_bound(lo);
+			for (; it != _by_value.end(); it++)
+				hs.emplace_back(it->second);
+		}
+
+		/// Append all atoms whose number is strictly less than `hi`.
+		void get_less(HandleSeq& hs, double hi) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			auto end = _by_value.lower_bound(hi);
+			for (auto it = _by_value.begin(); it != end; it++)
+				hs.emplace_back(it->second);
+		}
+
+		/// Append all atoms whose number lies in [lo, hi).
+		void get_range(HandleSeq& hs, double lo, double hi) const
+		{
+			if (hi <= lo) return;
+			std::lock_guard<std::mutex> lck(_mtx);
+			auto it = _by_value.lower_bound(lo);
+			auto end = _by_value.lower_bound(hi);
+			for (; it != end; it++)
+				hs.emplace_back(it->second);
+		}
+
+		/// Count the atoms that get_greater() would return.
+		size_t count_greater(double lo) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			return std::distance(_by_value.upper_bound(lo), _by_value.end());
+		}
+
+		/// Count the atoms that get_less() would return.
+		size_t count_less(double hi) const
+		{
+			std::lock_guard<std::mutex> lck(_mtx);
+			return std::distance(_by_value.begin(), _by_value.lower_bound(hi));
+		}
+};
+
+typedef std::shared_ptr<ValueIndex> ValueIndexPtr;
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_VALUEINDEX_H
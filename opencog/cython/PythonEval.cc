@@ -790,10 +790,13 @@ PyObject* PythonEval::find_object(PyObject* pyModule,
 }
 
 /**
- * Get the Python module and/or object and stripped function name, given
- * the identifer of the form '[module.][object.[attribute.]*]function'.
+ * Resolve the identifier of the form '[module.][object.[attribute.]*]function'
+ * down to the scope that holds the function: either the dictionary of
+ * the module, or the (innermost) object. The function itself is not
+ * looked up here; see fetch_function(). The caller must hold the GIL.
  */
-PyObject* PythonEval::get_function(const std::string& moduleFunction)
+void PythonEval::resolve_scope(const std::string& moduleFunction,
+                               PythonFunction& pyfn)
 {
     PyObject* pyModule = _pyRootModule;
     PyObject* pyObject = nullptr;
@@ -849,9 +852,12 @@ PyObject* PythonEval::get_function(const std::string& moduleFunction)
         }
 
         if (nullptr == pyObject)
+        {
+            PyErr_Clear();
             throw RuntimeException(TRACE_INFO,
                 "Python object/attribute for '%s' not found!",
                 functionName.c_str());
+        }
 
         functionName = functionName.substr(index+1);
         index = functionName.find_first_of('.');
@@ -860,62 +866,145 @@ PyObject* PythonEval::get_function(const std::string& moduleFunction)
     // For uniformity to DEC later in any case
     if (pyObject && !bDecRef) Py_INCREF(pyObject);
 
+    pyfn.name = moduleFunction;
+    pyfn.module = pyModule;
+    pyfn.in_dict = (nullptr == pyObject);
+    if (pyfn.in_dict)
+    {
+        // PyModule_GetDict returns a borrowed reference; promote it.
+        pyfn.scope = PyModule_GetDict(pyModule);
+        Py_INCREF(pyfn.scope);
+    }
+    else
+        pyfn.scope = pyObject;
+
+    // Interned, so that dictionary lookups compare pointers only.
+    pyfn.attr = PyUnicode_InternFromString(functionName.c_str());
+}
+
+/**
+ * Look up the function in a previously resolved scope. This is done
+ * on every call, and not cached, so that functions that are redefined
+ * after the first call are found. Returns a new reference; throws if
+ * the function is not there. The caller must hold the GIL.
+ */
+PyObject* PythonEval::fetch_function(const PythonFunction& pyfn)
+{
     PyObject* pyUserFunc;
 
-    // If there is no object, then search in module
-    if (nullptr == pyObject)
+    // If there is no object, then search in the module dictionary.
+    if (pyfn.in_dict)
     {
-#ifdef DEBUG
-        printf("Looking for %s in module %s; here's what we have:\n",
-            functionName.c_str(), PyModule_GetName(pyModule));
-        print_dictionary(pyDict);
-#endif
-        PyObject* pyDict = PyModule_GetDict(pyModule);
-        pyUserFunc = PyDict_GetItemString(pyDict, functionName.c_str());
+        // PyDict_GetItem returns a borrowed reference. Promote it,
+        // since it will be passed to a Python C API function later
+        // that "steals" it.
+        pyUserFunc = PyDict_GetItem(pyfn.scope, pyfn.attr);
+        Py_XINCREF(pyUserFunc);
     }
     else
-        pyUserFunc = PyObject_GetAttrString(pyObject, functionName.c_str());
+    {
+        // PyObject_GetAttr already returns a new reference.
+        pyUserFunc = PyObject_GetAttr(pyfn.scope, pyfn.attr);
+        if (nullptr == pyUserFunc) PyErr_Clear();
+    }
 
     // If we can't find that function then throw an exception.
     if (!pyUserFunc)
     {
-        if (pyObject) Py_DECREF(pyObject);
-        const char * moduleName = PyModule_GetName(pyModule);
+        const char * moduleName = PyModule_GetName(pyfn.module);
         throw RuntimeException(TRACE_INFO,
             "Python function '%s' not found in module '%s'!",
-            moduleFunction.c_str(), moduleName);
+            pyfn.name.c_str(), moduleName);
     }
 
-    // Promote the borrowed reference for pyUserFunc since it will
-    // be passed to a Python C API function later that "steals" it.
-    // PyObject_GetAttrString already returns new reference, so we
-    // do this only for PyDict_GetItemString
-    if (nullptr == pyObject) Py_INCREF(pyUserFunc);
-    if (pyObject) Py_DECREF(pyObject); // We don't need it anymore
-
     return pyUserFunc;
 }
 
+/**
+ * Get the Python function, given the identifer of the form
+ * '[module.][object.[attribute.]*]function'. Returns a new reference.
+ */
+PyObject* PythonEval::get_function(const std::string& moduleFunction)
+{
+    PythonFunction pyfn;
+    resolve_scope(moduleFunction, pyfn);
+
+    BOOST_SCOPE_EXIT(&pyfn) {
+        Py_DECREF(pyfn.scope);
+        Py_DECREF(pyfn.attr);
+    } BOOST_SCOPE_EXIT_END
+
+    return fetch_function(pyfn);
+}
+
+/**
+ * Resolve the function name just once, so that the name does not
+ * need to be re-parsed on every call. The returned object must be
+ * released with release_function().  Throws if the module or object
+ * path cannot be found; the function itself need not exist yet.
+ */
+PythonFunction* PythonEval::resolve_function(const std::string& moduleFunction)
+{
+    std::lock_guard<std::recursive_mutex> lck(_mtx);
+
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    BOOST_SCOPE_EXIT(&gstate) {
+        PyGILState_Release(gstate);
+    } BOOST_SCOPE_EXIT_END
+
+    PythonFunction* pyfn = new PythonFunction();
+    try
+    {
+        resolve_scope(moduleFunction, *pyfn);
+    }
+    catch (...)
+    {
+        delete pyfn;
+        throw;
+    }
+    return pyfn;
+}
+
+void PythonEval::release_function(PythonFunction* pyfn)
+{
+    if (nullptr == pyfn) return;
+
+    // Atoms holding resolved functions may outlive the interpreter.
+    if (Py_IsInitialized())
+    {
+        PyGILState_STATE gstate = PyGILState_Ensure();
+        Py_DECREF(pyfn->scope);
+        Py_DECREF(pyfn->attr);
+        PyGILState_Release(gstate);
+    }
+    delete pyfn;
+}
+
 // ===========================================================
 // Calling functions and applying functions to arguments
 // Most of these are part of the public API.
 
 std::recursive_mutex PythonEval::_mtx;
+std::atomic<bool> PythonEval::_concurrent(false);
+
+void PythonEval::set_concurrent(bool on)
+{
+    _concurrent = on;
+}
 
 /**
- * Get the user defined function.
+ * Call the user defined function.
  * On error throws an exception.
  */
 PyObject* PythonEval::do_call_user_function(const std::string& moduleFunction,
+                                            PyObject* pyUserFunc,
                                             PyObject* pyArguments)
 {
-    // Get a reference to the user function.
-    PyObject* pyUserFunc = get_function(moduleFunction);
-
     // Make sure the function is callable.
     if (!PyCallable_Check(pyUserFunc))
     {
         Py_DECREF(pyUserFunc);
+        Py_DECREF(pyArguments);
         throw RuntimeException(TRACE_INFO,
             "Python function '%s' not callable!", moduleFunction.c_str());
     }
@@ -944,11 +1033,13 @@ PyObject* PythonEval::do_call_user_function(const std::string& moduleFunction,
 
 /**
  * Call the user defined function with the arguments passed in the
- * ListLink handle 'arguments'.
+ * ListLink handle 'arguments'. If `pyfn` is not null, then it is
+ * used in place of looking up the function by name.
  *
  * On error throws an exception.
  */
 PyObject* PythonEval::call_user_function(const std::string& moduleFunction,
+                                         const PythonFunction* pyfn,
                                          Handle arguments)
 {
     // Get the actual argument count, passed in the ListLink.
@@ -956,7 +1047,9 @@ PyObject* PythonEval::call_user_function(const std::string& moduleFunction,
         throw RuntimeException(TRACE_INFO,
             "Expecting arguments to be a ListLink!");
 
-    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    // Lookup by name may load modules; that needs the lock.
+    std::unique_lock<std::recursive_mutex> lck(_mtx, std::defer_lock);
+    if (nullptr == pyfn or not _concurrent) lck.lock();
 
     // Grab the GIL.
     PyGILState_STATE gstate = PyGILState_Ensure();
@@ -970,6 +1063,10 @@ PyObject* PythonEval::call_user_function(const std::string& moduleFunction,
         PyGILState_Release(gstate);
     } BOOST_SCOPE_EXIT_END
 
+    // Get a reference to the user function.
+    PyObject* pyUserFunc = pyfn ?
+        fetch_function(*pyfn) : get_function(moduleFunction);
+
     // Create the Python tuple for the function call with python
     // atoms for each of the atoms in the link arguments.
     size_t nargs = arguments->get_arity();
@@ -978,7 +1075,7 @@ PyObject* PythonEval::call_user_function(const std::string& moduleFunction,
     for (size_t i=0; i<nargs; i++)
         PyTuple_SetItem(pyArguments, i, py_atom(args[i]));
 
-    return do_call_user_function(moduleFunction, pyArguments);
+    return do_call_user_function(moduleFunction, pyUserFunc, pyArguments);
 }
 
 /**
@@ -989,14 +1086,35 @@ ValuePtr PythonEval::apply_v(AtomSpace * as,
                              const std::string& func,
                              Handle varargs)
 {
-    std::lock_guard<std::recursive_mutex> lck(_mtx);
+    return do_apply_v(as, func, nullptr, varargs);
+}
+
+/**
+ * Same as above, but with the function name already resolved.
+ */
+ValuePtr PythonEval::apply_v(AtomSpace * as,
+                             const PythonFunction* pyfn,
+                             Handle varargs)
+{
+    return do_apply_v(as, pyfn->name, pyfn, varargs);
+}
+
+ValuePtr PythonEval::do_apply_v(AtomSpace * as,
+                                const std::string& func,
+                                const PythonFunction* pyfn,
+                                Handle varargs)
+{
+    // The context atomspace is thread-local, so when running
+    // concurrently, the lock is not needed to protect it.
+    std::unique_lock<std::recursive_mutex> lck(_mtx, std::defer_lock);
+    if (nullptr == pyfn or not _concurrent) lck.lock();
     push_context_atomspace(as);
     BOOST_SCOPE_EXIT(void) {
         pop_context_atomspace();
     } BOOST_SCOPE_EXIT_END
 
     // Get the python value object returned by this user function.
-    PyObject *pyValue = call_user_function(func, varargs);
+    PyObject *pyValue = call_user_function(func, pyfn, varargs);
 
     // If we got a non-null Value there were no errors.
     if (NULL == pyValue)
@@ -1081,7 +1199,8 @@ void PythonEval::apply_as(const std::string& moduleFunction,
     // Py_DECREF(pyAtomSpace);
 
     // Execute the user function.
-    do_call_user_function(moduleFunction, pyArguments);
+    PyObject* pyUserFunc = get_function(moduleFunction);
+    do_call_user_function(moduleFunction, pyUserFunc, pyArguments);
 }
 
 // ===================================================================
@@ -40,6 +40,7 @@
 
 #include "PyIncludeWrapper.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <mutex>
@@ -58,6 +59,22 @@ namespace opencog {
 
 class AtomSpace;
 
+/**
+ * A python function name, resolved down to the module dictionary or
+ * the object that holds the function. This avoids re-parsing the
+ * '[module.][object.]*function' name on each call. The function
+ * itself is still looked up (by interned name) at each call, so that
+ * redefinitions are seen.  See PythonEval::resolve_function().
+ */
+struct PythonFunction
+{
+    std::string name;   // The full, original name.
+    PyObject* module;   // Borrowed; used only for error messages.
+    PyObject* scope;    // Module dictionary, or object.
+    PyObject* attr;     // Interned function name.
+    bool in_dict;       // True if scope is a module dictionary.
+};
+
 /**
  * Singleton class used to initialize python interpreter in the main thread.
  * It also provides some handy functions, such as getPyAtomspace. These helper
@@ -82,13 +99,20 @@ class PythonEval : public GenericEval
         void print_dictionary(PyObject*);
         PyObject* find_object(PyObject* pyModule,
                               const std::string& objectName);
+        void resolve_scope(const std::string& moduleFunction,
+                           PythonFunction&);
+        PyObject* fetch_function(const PythonFunction&);
         PyObject* get_function(const std::string& moduleFunction);
         PyObject* do_call_user_function(const std::string& moduleFunction,
+                                        PyObject* pyUserFunc,
                                         PyObject* pyArguments);
 
         // Call functions; execute scripts.
         PyObject* call_user_function(const std::string& func,
+                                     const PythonFunction*,
                                      Handle varargs);
+        ValuePtr do_apply_v(AtomSpace*, const std::string& func,
+                            const PythonFunction*, Handle varargs);
         std::string build_python_error_message(const std::string&);
 
         std::string execute_string(const char*);
@@ -109,7 +133,13 @@ class PythonEval : public GenericEval
         // different atomspaces with the evaluator, in some nested
         // fashion. So this lock prevents other threads from using the
         // wrong atomspace in some other thread.  Quite unfortunate.
+        //
+        // Since then, the context atomspace has become thread-local,
+        // and so calls with pre-resolved functions (i.e. those coming
+        // from GroundedSchema/PredicateNodes) do not really need this
+        // lock. See set_concurrent() below.
         static std::recursive_mutex _mtx;
+        static std::atomic<bool> _concurrent;
 
         // Computed results are typically polled in a distinct thread.
         bool _eval_done;
@@ -150,6 +180,22 @@ class PythonEval : public GenericEval
          */
         static PythonEval & instance();
 
+        /**
+         * Allow grounded python functions to be called from multiple
+         * threads at the same time. When enabled, calls made with a
+         * pre-resolved PythonFunction (which is what the grounded
+         * nodes use) no longer take the global evaluator lock; only
+         * the GIL is taken.  With the standard interpreter, the GIL
+         * is released whenever the callback blocks, or calls C code
+         * that releases it; with a free-threaded interpreter (built
+         * with Py_GIL_DISABLED) the callbacks run fully in parallel.
+         *
+         * The python functions themselves must then be thread-safe.
+         * Off by default.
+         */
+        static void set_concurrent(bool);
+        static bool is_concurrent(void) { return _concurrent; }
+
         // The async-output interface.
         virtual void begin_eval(void);
         virtual void eval_expr(const std::string&);
@@ -170,6 +216,20 @@ class PythonEval : public GenericEval
         virtual ValuePtr apply_v(AtomSpace * as, const std::string& func,
                          Handle varargs);
 
+        /**
+         * Resolve the function name `func` just once, for repeated
+         * use with apply_v() below. Must be released with
+         * release_function().
+         */
+        virtual PythonFunction* resolve_function(const std::string& func);
+        virtual void release_function(PythonFunction*);
+
+        /**
+         * Same as apply_v() above, but with a pre-resolved function.
+         */
+        virtual ValuePtr apply_v(AtomSpace * as, const PythonFunction*,
+                                 Handle varargs);
+
         /**
          * Calls the Python function passed in `func`, passing it
          * the `varargs` as an argument, and returning a Handle.
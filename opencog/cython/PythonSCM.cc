@@ -45,6 +45,7 @@ public:
 	PythonSCM();
 	std::string eval(const std::string&);
 	void apply_as(const std::string&, AtomSpace*);
+	void set_concurrent(bool);
 }; // class
 
 /** @}*/
@@ -123,6 +124,7 @@ void PythonSCM::init(void)
 {
 	define_scheme_primitive("python-eval", &PythonSCM::eval, this, "python");
 	define_scheme_primitive("python-call-with-as", &PythonSCM::apply_as, this, "python");
+	define_scheme_primitive("python-set-concurrent!", &PythonSCM::set_concurrent, this, "python");
 }
 
 std::string PythonSCM::eval(const std::string& pystr)
@@ -138,6 +140,11 @@ void PythonSCM::apply_as(const std::string& pystr, AtomSpace* as)
 	pyev.apply_as(pystr, as);
 }
 
+void PythonSCM::set_concurrent(bool on)
+{
+	PythonEval::set_concurrent(on);
+}
+
 void opencog_python_init(void)
 {
 	static PythonSCM patty;
@@ -2,6 +2,8 @@
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/execution/Instantiator.h>
+#include <opencog/atoms/pattern/QueryLink.h>
+#include <opencog/atoms/value/QueueValue.h>
 #include <opencog/atoms/value/Value.h>
 
 #include "BindlinkStub.h"
@@ -16,3 +18,27 @@ ValuePtr opencog::do_execute(AtomSpace* atomspace, Handle h)
 		return atomspace->add_atom(HandleCast(pap));
 	return pap;
 }
+
+ValuePtr opencog::do_execute_stream(AtomSpace* atomspace, Handle h,
+                                    size_t capacity)
+{
+	QueryLinkPtr qlp(QueryLinkCast(h));
+	if (nullptr == qlp)
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a QueryLink, got %s", h->to_short_string().c_str());
+	return qlp->execute_stream(atomspace, capacity);
+}
+
+bool opencog::stream_next(ValuePtr queue, ValuePtr& val)
+{
+	return QueueValueCast(queue)->next(val);
+}
+
+void opencog::stream_halt(ValuePtr queue)
+{
+	// Wait for the search to stop; python may drop the AtomSpace
+	// right after this.
+	QueueValuePtr qv(QueueValueCast(queue));
+	qv->halt();
+	qv->wait_for_writer();
+}
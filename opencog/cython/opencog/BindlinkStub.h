@@ -28,6 +28,11 @@ namespace opencog {
 
 ValuePtr do_execute(AtomSpace*, Handle);
 
+// Streaming query results; see QueryLink::execute_stream()
+ValuePtr do_execute_stream(AtomSpace*, Handle, size_t);
+bool stream_next(ValuePtr, ValuePtr&);
+void stream_halt(ValuePtr);
+
 } // namespace opencog
 
 
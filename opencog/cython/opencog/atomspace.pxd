@@ -3,6 +3,7 @@ from libcpp.vector cimport vector
 from libcpp.memory cimport shared_ptr
 from libcpp.set cimport set as cpp_set
 from libcpp.string cimport string
+from libc.stdint cimport uint32_t, uint64_t
 from cython.operator cimport dereference as deref
 
 
@@ -192,6 +193,17 @@ cdef class Atom(Value):
 
 cdef vector[cHandle] atom_list_to_vector(list lst);
 
+# Dense atom ids
+cdef extern from "opencog/atomspace/AtomIdIndex.h" namespace "opencog":
+    cdef uint32_t INVALID_ATOM_ID
+    cdef cppclass cAtomCSR "opencog::AtomCSR":
+        vector[uint32_t] ids
+        vector[Type] types
+        vector[uint64_t] out_offsets
+        vector[uint32_t] out_edges
+        vector[uint64_t] in_offsets
+        vector[uint32_t] in_edges
+
 # AtomSpace
 cdef extern from "opencog/atomspace/AtomSpace.h" namespace "opencog":
     cdef cppclass cAtomSpace "opencog::AtomSpace":
@@ -211,6 +223,8 @@ cdef extern from "opencog/atomspace/AtomSpace.h" namespace "opencog":
 
         cHandle set_value(cHandle h, cHandle key, cValuePtr value)
         cHandle set_truthvalue(cHandle h, tv_ptr tvn)
+        vector[cValuePtr] get_values(const vector[cHandle]&, const cHandle& key) nogil except +
+        vector[cHandle] set_values(const vector[cHandle]&, const cHandle& key, const vector[cValuePtr]&) nogil except +
         cHandle get_atom(cHandle & h)
         bint is_valid_handle(cHandle h)
         int get_size()
@@ -218,6 +232,22 @@ cdef extern from "opencog/atomspace/AtomSpace.h" namespace "opencog":
         # ==== query methods ====
         # get by type
         output_iterator get_handles_by_type(output_iterator, Type t, bint subclass)
+        void get_partitions_by_type(vector[vector[cHandle]]&, Type t, bint subclass, size_t nparts)
+
+        # by name
+        void add_name_index(Type t) except +
+        void remove_name_index(Type t)
+        vector[cHandle] get_nodes_by_prefix(Type t, string prefix)
+        vector[cHandle] get_nodes_by_substring(Type t, string sub)
+        vector[cHandle] get_nodes_by_name(string name)
+
+        # dense atom ids
+        void enable_atom_ids()
+        void disable_atom_ids()
+        uint32_t get_atom_id(const cHandle&)
+        cHandle get_atom_by_id(uint32_t)
+        size_t get_atom_id_bound()
+        void export_csr(cAtomCSR&, const cpp_set[Type]&, bint subclass) nogil except +
 
         void clear()
         bint remove_atom(cHandle h, bint recursive)
@@ -241,6 +271,7 @@ cdef extern from "opencog/atoms/value/FloatValue.h" namespace "opencog":
         cFloatValue(double value)
         cFloatValue(const vector[double]& values)
         const vector[double]& value() const
+        size_t size() const
 
 
 # StringValue
@@ -1,7 +1,9 @@
 from libcpp cimport bool
 from libcpp.set cimport set as cpp_set
 from libcpp.vector cimport vector
+from cpython.buffer cimport PyObject_CheckBuffer
 from cython.operator cimport dereference as deref, preincrement as inc
+from array import array
 
 # from atomspace cimport *
 
@@ -13,6 +15,14 @@ cdef api string get_path_as_string() with gil:
     import sys
     return str(sys.path).encode('UTF-8')
 
+# Copy n items of a C array into a python array of the given typecode;
+# the typecode must match the C type.
+cdef vector_to_array(typecode, const void* data, size_t n):
+    result = array(typecode)
+    if 0 < n:
+        result.frombytes((<const char*> data)[:n * result.itemsize])
+    return result
+
 cdef convert_handle_seq_to_python_list(vector[cHandle] handles):
     cdef vector[cHandle].iterator handle_iter
     cdef cHandle handle
@@ -192,6 +202,93 @@ cdef class AtomSpace:
             return None
         self.atomspace.set_truthvalue(deref(atom.handle), deref(tv._tvptr()))
 
+    def get_values(self, atoms, Atom key):
+        """ Return the values at key on each of the atoms, in order,
+        with None for the atoms that have no such value. The values are
+        fetched in a single call, using several threads for long lists.
+        """
+        cdef vector[cHandle] handles = atom_list_to_vector(list(atoms))
+        cdef vector[cValuePtr] values
+        with nogil:
+            values = self.atomspace.get_values(handles, deref(key.handle))
+        return [None if v.get() == NULL else create_python_value_from_c_value(v)
+                for v in values]
+
+    def get_float_values(self, atoms, Atom key, double missing=float('nan')):
+        """ Return the FloatValues at key on each of the atoms, as a
+        2-D array of doubles, one row per atom. Values shorter than the
+        longest one, and absent values, are padded with `missing`.
+        The result supports the buffer protocol; numpy.asarray() turns
+        it into an ndarray without copying. If there are no atoms, or no
+        numbers at all, the result is an empty one-dimensional view.
+        """
+        cdef vector[cHandle] handles = atom_list_to_vector(list(atoms))
+        cdef vector[cValuePtr] values
+        with nogil:
+            values = self.atomspace.get_values(handles, deref(key.handle))
+
+        cdef Type float_type = types.FloatValue
+        cdef size_t width = 0
+        cdef size_t i, j
+        cdef const vector[double]* vec
+        for i in range(values.size()):
+            if values[i].get() == NULL:
+                continue
+            if not nameserver().isA(values[i].get().get_type(), float_type):
+                raise TypeError('The value on atom {} is not a FloatValue'
+                                .format(i))
+            width = max(width, (<cFloatValue*>values[i].get()).size())
+
+        if 0 == values.size() * width:
+            return memoryview(array('d'))
+
+        data = array('d', bytes(values.size() * width * sizeof(double)))
+        cdef double[::1] flat = data
+        for i in range(values.size()):
+            j = 0
+            if values[i].get() != NULL:
+                vec = &((<cFloatValue*>values[i].get()).value())
+                for j in range(vec.size()):
+                    flat[i * width + j] = deref(vec)[j]
+                j = vec.size()
+            for j in range(j, width):
+                flat[i * width + j] = missing
+        return memoryview(data).cast('B').cast('d', [values.size(), width])
+
+    def set_values(self, atoms, Atom key, values):
+        """ Set the value at key on each of the atoms; the i'th value
+        goes on the i'th atom. The values are either a list of Values
+        (None removes the key), or a 2-D array of numbers, such as a
+        numpy array, each row of which becomes a FloatValue. Returns
+        the list of atoms that were changed; these differ from the given
+        atoms only if the atomspace is copy-on-write.
+        """
+        cdef vector[cHandle] handles = atom_list_to_vector(list(atoms))
+        cdef vector[cValuePtr] vals
+        cdef cValuePtr vp
+        cdef const double[:, :] rows
+        cdef vector[double] row
+        cdef Py_ssize_t i, j
+        if PyObject_CheckBuffer(values):
+            rows = values
+            row.resize(rows.shape[1])
+            for i in range(rows.shape[0]):
+                for j in range(rows.shape[1]):
+                    row[j] = rows[i, j]
+                vp.reset(<cValue*>new cFloatValue(row))
+                vals.push_back(vp)
+        else:
+            for v in values:
+                vp.reset()
+                if v is not None:
+                    vp = (<Value?>v).get_c_value_ptr()
+                vals.push_back(vp)
+
+        cdef vector[cHandle] changed
+        with nogil:
+            changed = self.atomspace.set_values(handles, deref(key.handle), vals)
+        return convert_handle_seq_to_python_list(changed)
+
     # Methods to make the atomspace act more like a standard Python container
     def __contains__(self, atom):
         """ Custom checker to see if object is in AtomSpace """
@@ -232,6 +329,114 @@ cdef class AtomSpace:
         self.atomspace.get_handles_by_type(back_inserter(handle_vector),t,subt)
         return convert_handle_seq_to_python_list(handle_vector)
 
+    def get_partitions_by_type(self, Type t, subtype = True, nparts = 0):
+        """
+        Return the atoms of type t, as a list of about nparts lists.
+        The parts can be handed out to worker threads or processes;
+        each part covers a separate range of the atomspace index. If
+        nparts is zero, a few parts per CPU are made.
+        """
+        if self.atomspace == NULL:
+            return None
+        cdef vector[vector[cHandle]] parts
+        cdef bint subt = subtype
+        self.atomspace.get_partitions_by_type(parts, t, subt, nparts)
+        return [convert_handle_seq_to_python_list(part) for part in parts]
+
+    def add_name_index(self, Type t):
+        """
+        Maintain a sorted index of the names of all nodes of type t.
+        This makes get_nodes_by_prefix() and get_nodes_by_name() fast.
+        """
+        self.atomspace.add_name_index(t)
+
+    def remove_name_index(self, Type t):
+        self.atomspace.remove_name_index(t)
+
+    def get_nodes_by_prefix(self, Type t, prefix):
+        """ Return all nodes of type t whose name starts with prefix """
+        if self.atomspace == NULL:
+            return None
+        cdef string cprefix = prefix.encode('UTF-8')
+        return convert_handle_seq_to_python_list(
+            self.atomspace.get_nodes_by_prefix(t, cprefix))
+
+    def get_nodes_by_substring(self, Type t, sub):
+        """ Return all nodes of type t whose name contains sub """
+        if self.atomspace == NULL:
+            return None
+        cdef string csub = sub.encode('UTF-8')
+        return convert_handle_seq_to_python_list(
+            self.atomspace.get_nodes_by_substring(t, csub))
+
+    def get_nodes_by_name(self, name):
+        """ Return all nodes, of any type, with the given name """
+        if self.atomspace == NULL:
+            return None
+        cdef string cname = name.encode('UTF-8')
+        return convert_handle_seq_to_python_list(
+            self.atomspace.get_nodes_by_name(cname))
+
+    def enable_atom_ids(self):
+        """
+        Give every atom in this atomspace a small, dense integer id,
+        so that graph algorithms can index plain arrays with them.
+        Atoms added later get an id when they are added; the ids of
+        removed atoms are reused.
+        """
+        self.atomspace.enable_atom_ids()
+
+    def disable_atom_ids(self):
+        self.atomspace.disable_atom_ids()
+
+    def get_atom_id(self, Atom atom):
+        """ Return the id of the atom, or None if it has none """
+        cdef uint32_t aid = self.atomspace.get_atom_id(deref(atom.handle))
+        if aid == INVALID_ATOM_ID:
+            return None
+        return aid
+
+    def get_atom_by_id(self, uint32_t aid):
+        """ Return the atom with the given id, or None """
+        cdef cHandle result = self.atomspace.get_atom_by_id(aid)
+        if result == result.UNDEFINED: return None
+        return Atom.createAtom(result)
+
+    def get_atom_id_bound(self):
+        """ All atom ids are less than this """
+        return self.atomspace.get_atom_id_bound()
+
+    def export_csr(self, types, subtype=True):
+        """
+        Return the graph formed by the atoms of the given types (and
+        their subtypes), in compressed sparse row form. The links point
+        at the atoms in their outgoing sets. Vertex v is the atom with
+        id ids[v]; its outgoing edges are
+        out_edges[out_offsets[v]:out_offsets[v+1]], and likewise for the
+        incoming edges. The result is a dict of arrays, all of which
+        support the buffer protocol, e.g. for numpy or scipy.sparse.
+        This turns on atom ids.
+        """
+        cdef cpp_set[Type] ctypes
+        for t in types:
+            ctypes.insert(t)
+        cdef bint subt = subtype
+        cdef cAtomCSR csr
+        with nogil:
+            self.atomspace.export_csr(csr, ctypes, subt)
+
+        return {
+            'ids': vector_to_array('I', csr.ids.data(), csr.ids.size()),
+            'types': vector_to_array('h', csr.types.data(), csr.types.size()),
+            'out_offsets': vector_to_array('Q', csr.out_offsets.data(),
+                                           csr.out_offsets.size()),
+            'out_edges': vector_to_array('I', csr.out_edges.data(),
+                                         csr.out_edges.size()),
+            'in_offsets': vector_to_array('Q', csr.in_offsets.data(),
+                                          csr.in_offsets.size()),
+            'in_edges': vector_to_array('I', csr.in_edges.data(),
+                                        csr.in_edges.size())}
+
     @classmethod
     def include_incoming(cls, atoms):
         """
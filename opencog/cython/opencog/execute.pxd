@@ -7,3 +7,6 @@ cdef extern from "opencog/atoms/execution/EvaluationLink.h" namespace "opencog":
 
 cdef extern from "opencog/cython/opencog/BindlinkStub.h" namespace "opencog":
     cdef cValuePtr c_execute_atom "do_execute"(cAtomSpace*, cHandle) except +
+    cdef cValuePtr c_execute_stream "do_execute_stream"(cAtomSpace*, cHandle, size_t) except +
+    cdef bint c_stream_next "stream_next"(cValuePtr, cValuePtr&) nogil
+    cdef void c_stream_halt "stream_halt"(cValuePtr) nogil
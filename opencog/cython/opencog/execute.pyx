@@ -17,6 +17,32 @@ def execute_atom(AtomSpace atomspace, Atom atom):
     return create_python_value_from_c_value(c_value_ptr)
 
 
+def execute_stream(AtomSpace atomspace, Atom query, size_t capacity=1000):
+    """
+    Run the QueryLink `query` in a background thread, and yield its
+    results as they are found. The search waits whenever `capacity`
+    results are waiting to be read; it is stopped when the generator
+    is closed, e.g. by breaking out of the loop over it.
+    """
+    if query is None:
+        raise ValueError("execute_stream query is: None")
+    cdef cValuePtr queue = c_execute_stream(
+        atomspace.atomspace, deref(query.handle), capacity
+    )
+    cdef cValuePtr c_value
+    cdef bint got
+    try:
+        while True:
+            with nogil:
+                got = c_stream_next(queue, c_value)
+            if not got:
+                return
+            yield create_python_value_from_c_value(c_value)
+    finally:
+        with nogil:
+            c_stream_halt(queue)
+
+
 def evaluate_atom(AtomSpace atomspace, Atom atom):
     if atom is None:
         raise ValueError("evaluate_atom atom is: None")
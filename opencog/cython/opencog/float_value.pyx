@@ -1,13 +1,36 @@
+from cpython.buffer cimport PyObject_CheckBuffer
 
 def createFloatValue(arg):
+    """
+    Create a FloatValue from a number, a list of numbers, or any object
+    that supports the buffer protocol, e.g. a numpy array or an
+    array.array. A one-dimensional buffer of doubles is copied in a
+    single pass, without going through a python list.
+    """
     cdef shared_ptr[cFloatValue] c_ptr
     if (isinstance(arg, list)):
         c_ptr.reset(new cFloatValue(FloatValue.list_of_doubles_to_vector(arg)))
+    elif PyObject_CheckBuffer(arg):
+        c_ptr.reset(new cFloatValue(FloatValue.buffer_to_vector(arg)))
     else:
         c_ptr.reset(new cFloatValue(<double>arg))
     return FloatValue(PtrHolder.create(<shared_ptr[void]&>c_ptr))
 
 cdef class FloatValue(Value):
+    """
+    FloatValues support the buffer protocol, so that e.g.
+    numpy.asarray(value) is a read-only view of the value, and does not
+    copy it.
+    """
+
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+        float_value_getbuffer(self, buffer, flags)
+
+    def __releasebuffer__(self, Py_buffer* buffer):
+        float_value_releasebuffer(buffer)
+
+    def __len__(self):
+        return (<cFloatValue*>self.get_c_value_ptr().get()).size()
 
     def to_list(self):
         return FloatValue.vector_of_doubles_to_list(
@@ -21,6 +44,33 @@ cdef class FloatValue(Value):
             cpp_vector.push_back(value)
         return cpp_vector
 
+    @staticmethod
+    cdef vector[double] buffer_to_vector(object buf):
+        cdef vector[double] cpp_vector
+        cdef const double[::1] contiguous
+        cdef const double[:] strided
+        cdef Py_ssize_t i
+        try:
+            contiguous = buf
+        except (ValueError, TypeError):
+            pass
+        else:
+            if contiguous.shape[0] > 0:
+                cpp_vector.resize(contiguous.shape[0])
+                memcpy(cpp_vector.data(), &contiguous[0],
+                       contiguous.shape[0] * sizeof(double))
+            return cpp_vector
+        try:
+            strided = buf
+        except (ValueError, TypeError):
+            # Some other element type; convert one at a time.
+            return FloatValue.list_of_doubles_to_vector(
+                [float(x) for x in memoryview(buf).tolist()])
+        cpp_vector.resize(strided.shape[0])
+        for i in range(strided.shape[0]):
+            cpp_vector[i] = strided[i]
+        return cpp_vector
+
     @staticmethod
     cdef list vector_of_doubles_to_list(const vector[double]* cpp_vector):
         list = []
@@ -29,6 +29,13 @@ cdef class TruthValue(Value):
     #         c_ptr.reset(new cSimpleTruthValue(strength, confidence))
     #         super().__init__(PtrHolder.create(<shared_ptr[void]&>c_ptr))
 
+    # The strength and the confidence, as a read-only buffer.
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+        float_value_getbuffer(self, buffer, flags)
+
+    def __releasebuffer__(self, Py_buffer* buffer):
+        float_value_releasebuffer(buffer)
+
     @property
     def mean(self):
         return self._mean()
@@ -25,3 +25,4 @@ cdef extern from "opencog/cython/executioncontext/Context.h" namespace "opencog"
 # source location, not the install location.
 cdef extern from "opencog/persist/sexpr/fast_load.h" namespace "opencog":
     void load_file(const string path, cAtomSpace & atomspace);
+    void dump_file(const string path, cAtomSpace & atomspace, Type t, bint subclass) except +
@@ -5,8 +5,9 @@ from opencog.atomspace cimport cValuePtr, create_python_value_from_c_value
 from opencog.atomspace cimport AtomSpace_factory
 
 from contextlib import contextmanager
-from opencog.atomspace import create_child_atomspace
+from opencog.atomspace import create_child_atomspace, types
 from opencog.utilities cimport load_file as c_load_file
+from opencog.utilities cimport dump_file as c_dump_file
 import warnings
 
 
@@ -118,3 +119,13 @@ def pop_default_atomspace():
 def load_file(path, AtomSpace atomspace):
     cdef string p = path.encode('utf-8')
     c_load_file(p, deref(atomspace.atomspace))
+
+def dump_file(path, AtomSpace atomspace, t=None, subclass=True):
+    """
+    Write the atoms of type `t` (all atoms, by default), along with
+    their values, to a file that load_file() can read back.
+    """
+    cdef string p = path.encode('utf-8')
+    if t is None:
+        t = types.Atom
+    c_dump_file(p, deref(atomspace.atomspace), t, subclass)
@@ -1,5 +1,8 @@
 from cpython.object cimport Py_EQ, Py_NE
+from cpython.buffer cimport PyBUF_WRITABLE, PyBUF_FORMAT, PyBUF_ND, PyBUF_STRIDES
 from cython.operator cimport dereference as deref
+from libc.stdlib cimport malloc, free
+from libc.string cimport memcpy
 
 
 cdef class PtrHolder:
@@ -84,3 +87,58 @@ cdef class Value:
         else:
             raise TypeError('Value can be compared using '
                             + 'Py_EQ and Py_NE only')
+
+
+# Buffer protocol for the values that hold a vector of doubles, i.e.
+# FloatValues and the TruthValues. Values are immutable, so the buffer
+# is read-only, and points straight at the C++ vector; the buffer keeps
+# the value alive. Streams recompute their vector each time that it is
+# asked for, so those get a private snapshot instead.
+cdef int float_value_getbuffer(Value value, Py_buffer* buffer,
+                               int flags) except -1:
+    if flags & PyBUF_WRITABLE:
+        raise BufferError('{} is immutable'.format(value.type_name))
+    if value.is_a(types.TensorTruthValue):
+        raise BufferError('TensorTruthValue does not hold its data')
+
+    cdef const vector[double]* vec = \
+        &((<cFloatValue*>value.get_c_value_ptr().get()).value())
+    cdef Py_ssize_t n = vec.size()
+    cdef bint copy = value.is_a(types.StreamValue)
+
+    # Room for the shape and the stride, and for the snapshot.
+    cdef Py_ssize_t* dims = <Py_ssize_t*> malloc(
+        2 * sizeof(Py_ssize_t) + (n * sizeof(double) if copy else 0))
+    if dims == NULL:
+        raise MemoryError()
+    dims[0] = n
+    dims[1] = sizeof(double)
+
+    if copy:
+        buffer.buf = <void*>&dims[2]
+        if n > 0:
+            memcpy(buffer.buf, vec.data(), n * sizeof(double))
+    else:
+        buffer.buf = <void*>vec.data()
+
+    buffer.obj = value
+    buffer.len = n * sizeof(double)
+    buffer.readonly = 1
+    buffer.itemsize = sizeof(double)
+    buffer.format = NULL
+    if flags & PyBUF_FORMAT:
+        buffer.format = 'd'
+    buffer.ndim = 1
+    buffer.shape = NULL
+    if (flags & PyBUF_ND) == PyBUF_ND:
+        buffer.shape = dims
+    buffer.strides = NULL
+    if (flags & PyBUF_STRIDES) == PyBUF_STRIDES:
+        buffer.strides = &dims[1]
+    buffer.suboffsets = NULL
+    buffer.internal = <void*>dims
+    return 0
+
+cdef void float_value_releasebuffer(Py_buffer* buffer):
+    free(buffer.internal)
+
@@ -9,6 +9,7 @@
 
 #include <atomic>
 
+#include <locale.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -31,6 +32,15 @@ using namespace opencog;
 
 static std::mutex init_mtx;
 
+// Same as evaluating (setlocale LC_ALL "") and then
+// (setlocale LC_NUMERIC "C") but without the overhead of having
+// guile parse and evaluate strings. This runs once per thread.
+static void set_locale(void)
+{
+	scm_setlocale(scm_from_int(LC_ALL), scm_from_utf8_string(""));
+	scm_setlocale(scm_from_int(LC_NUMERIC), scm_from_utf8_string("C"));
+}
+
 /**
  * This init is called once for every time that this class
  * is instantiated -- i.e. it is a per-instance initializer.
@@ -46,9 +56,8 @@ void SchemeEval::init(void)
 #define WORK_AROUND_GUILE_UTF8_BUGS
 #ifdef WORK_AROUND_GUILE_UTF8_BUGS
 	// Arghhh!  Avoid ongoing utf8 fruitcake nutiness in guile-2.0
-	scm_c_eval_string ("(setlocale LC_ALL \"\")\n");
-	// Force iso standard numeric formatting
-	scm_c_eval_string ("(setlocale LC_NUMERIC \"C\")\n");
+	// Also force iso standard numeric formatting.
+	set_locale();
 #endif // WORK_AROUND_GUILE_UTF8_BUGS
 
 	SchemeSmob::init();
@@ -68,6 +77,7 @@ void SchemeEval::init(void)
 	_captured_stack = scm_gc_protect_object(_captured_stack);
 
 	_pexpr = NULL;
+	_pproc = SCM_BOOL_F;
 	_eval_done = true;
 	_poll_done = true;
 
@@ -304,9 +314,8 @@ void SchemeEval::per_thread_init(void)
 
 #ifdef WORK_AROUND_GUILE_UTF8_BUGS
 	// Arghhh!  Avoid ongoing utf8 fruitcake nutiness in guile-2.0
-	scm_c_eval_string ("(setlocale LC_ALL \"\")\n");
-	// Force iso standard numeric formatting
-	scm_c_eval_string ("(setlocale LC_NUMERIC \"C\")\n");
+	// Also force iso standard numeric formatting.
+	set_locale();
 #endif // WORK_AROUND_GUILE_UTF8_BUGS
 }
 
@@ -802,7 +811,7 @@ SCM SchemeEval::do_scm_eval(SCM sexpr, SCM (*evo)(void *))
 		set_captured_stack(SCM_BOOL_F);
 
 		// ?? Why are we discarding the output??
-		drain_output();
+		if (_in_shell) drain_output();
 
 		// Stick the guile stack trace into a string. Anyone who called
 		// us is responsible for checking for an error, and handling
@@ -814,8 +823,14 @@ SCM SchemeEval::do_scm_eval(SCM sexpr, SCM (*evo)(void *))
 		return SCM_EOL;
 	}
 
-	// Get the contents of the output port, and log it
-	if (_in_server and logger().is_info_enabled())
+	// Get the contents of the output port, and log it. If we are
+	// in_shell, then we are here probably because user typed something
+	// that caused some ExecutionOutputLink to call some scheme snippet.
+	//
+	// Programmatic calls (i.e. not from the shell) never redirect the
+	// output into the pipe, and so there is nothing there to log or to
+	// drain.  Skip the syscalls; they dominate short calls.
+	if (_in_server and _in_shell and logger().is_info_enabled())
 	{
 		std::string str(poll_port());
 		if (0 < str.size())
@@ -826,15 +841,6 @@ SCM SchemeEval::do_scm_eval(SCM sexpr, SCM (*evo)(void *))
 		}
 	}
 
-	// If we are in the cogserver, but are not in a shell context,
-	// then truncate the output, because it will never ever be displayed.
-	// (i.e. don't overflow the output buffers.) If we are in_shell,
-	// then we are here probably because user typed something that
-	// caused some ExecutionOutputLink to call some scheme snippet.
-	// We do want to display that.
-	if (_in_server and not _in_shell)
-		drain_output();
-
 	return rc;
 }
 
@@ -990,6 +996,30 @@ static SCM thunk_scm_eval(void * expr)
 	return scm_eval((SCM)expr, scm_interaction_environment());
 }
 
+/**
+ * Convert the arguments in varargs into a scheme list. If varargs is
+ * a ListLink, its elements are passed to the function, otherwise the
+ * single argument is passed.
+ */
+static SCM varargs_to_scm(const Handle& varargs)
+{
+	SCM args = SCM_EOL;
+	if (nullptr == varargs) return args;
+
+	if (varargs->get_type() != LIST_LINK)
+		return scm_list_1(SchemeSmob::handle_to_scm(varargs));
+
+	// Iterate in reverse, because cons chains in reverse.
+	const HandleSeq &oset = varargs->getOutgoingSet();
+	size_t sz = oset.size();
+	for (int i=sz-1; i>=0; i--)
+	{
+		SCM sh = SchemeSmob::handle_to_scm(oset[i]);
+		args = scm_cons(sh, args);
+	}
+	return args;
+}
+
 /**
  * do_apply_scm -- apply named function func to arguments in ListLink
  * It is assumed that varargs is a ListLink, containing a list of
@@ -999,26 +1029,7 @@ static SCM thunk_scm_eval(void * expr)
 SCM SchemeEval::do_apply_scm(const std::string& func, const Handle& varargs )
 {
 	SCM sfunc = scm_from_utf8_symbol(func.c_str());
-	SCM expr = SCM_EOL;
-
-	// If there were args, pass the args to the function.
-	if (varargs)
-	{
-		// If varargs is a ListLink, its elements are passed to the
-		// function, otherwise the single argument is passed.
-		HandleSeq single_arg{varargs};
-		const HandleSeq &oset = varargs->get_type() == LIST_LINK ?
-			varargs->getOutgoingSet() : single_arg;
-
-		// Iterate in reverse, because cons chains in reverse.
-		size_t sz = oset.size();
-		for (int i=sz-1; i>=0; i--)
-		{
-			SCM sh = SchemeSmob::handle_to_scm(oset[i]);
-			expr = scm_cons(sh, expr);
-		}
-	}
-	expr = scm_cons(sfunc, expr);
+	SCM expr = scm_cons(sfunc, varargs_to_scm(varargs));
 
 	// TODO: it would be nice to pass exceptions on through, but
 	// this currently breaks unit tests.
@@ -1027,6 +1038,64 @@ SCM SchemeEval::do_apply_scm(const std::string& func, const Handle& varargs )
 	return do_scm_eval(expr, thunk_scm_eval);
 }
 
+static SCM thunk_scm_apply(void * expr)
+{
+	SCM var = scm_car((SCM)expr);
+	return scm_apply_0(scm_variable_ref(var), scm_cdr((SCM)expr));
+}
+
+/**
+ * do_apply_proc -- same as do_apply_scm(), except that the name is
+ * already a symbol. The procedure is looked up in the current module,
+ * just as evaluating the expression would do, and then applied
+ * directly; this avoids creating a symbol, and then building and
+ * evaluating an expression, on every call. Looking it up at each call
+ * means that procedures defined, re-defined or shadowed after the
+ * first call are still found. Names that are not bound to procedures
+ * (e.g. macros) are evaluated as an expression, as before, so that
+ * errors are reported just as before, too.
+ */
+SCM SchemeEval::do_apply_proc(SCM sym, const Handle& varargs)
+{
+	SCM var = scm_module_variable(scm_interaction_environment(), sym);
+	if (scm_is_false(var) or
+	    scm_is_false(scm_variable_bound_p(var)) or
+	    scm_is_false(scm_procedure_p(scm_variable_ref(var))))
+		return do_scm_eval(scm_cons(sym, varargs_to_scm(varargs)),
+		                   thunk_scm_eval);
+
+	SCM expr = scm_cons(var, varargs_to_scm(varargs));
+	return do_scm_eval(expr, thunk_scm_apply);
+}
+
+void * SchemeEval::c_wrap_intern_proc(void * p)
+{
+	SchemeEval *self = (SchemeEval *) p;
+	SCM sym = scm_from_utf8_symbol(self->_pexpr->c_str());
+
+	// Symbols that nothing refers to may be collected; the caller will
+	// cache this one, outside of the reach of the garbage collector.
+	self->_pproc = scm_gc_protect_object(sym);
+	return self;
+}
+
+/**
+ * intern_proc -- return the symbol naming the procedure, protected
+ * from garbage collection. It is meant to be cached, and then passed
+ * to apply_proc().
+ */
+SCM SchemeEval::intern_proc(const std::string& func)
+{
+	const std::string* saved_expr = _pexpr;
+	_pexpr = &func;
+	scm_with_guile(c_wrap_intern_proc, this);
+	_pexpr = saved_expr;
+
+	SCM sym = _pproc;
+	_pproc = SCM_BOOL_F;
+	return sym;
+}
+
 /* ============================================================== */
 /**
  * apply_v -- apply named function func to arguments in ListLink.
@@ -1082,6 +1151,47 @@ void * SchemeEval::c_wrap_apply_v(void * p)
 	return self;
 }
 
+/**
+ * apply_proc -- same as apply_v(), except that the procedure is named
+ * by a symbol previously obtained from intern_proc().
+ */
+ValuePtr SchemeEval::apply_proc(SCM sym, Handle varargs)
+{
+	// If we are recursing, then we already are in the guile
+	// environment, and don't need to do any additional setup.
+	if (_in_eval) {
+		SCM smob = do_apply_proc(sym, varargs);
+		if (eval_error())
+			throw RuntimeException(TRACE_INFO, "%s", _error_msg.c_str());
+		return SchemeSmob::scm_to_protom(smob);
+	}
+
+	_pproc = sym;
+	_hargs = varargs;
+	_in_eval = true;
+	scm_with_guile(c_wrap_apply_proc, this);
+	_in_eval = false;
+	_hargs = nullptr;
+	_pproc = SCM_BOOL_F;
+
+	if (eval_error())
+		throw RuntimeException(TRACE_INFO, "%s", _error_msg.c_str());
+
+	// We do not want this->_retval to point at anything after we return.
+	ValuePtr rv;
+	swap(rv, _retval);
+	return rv;
+}
+
+void * SchemeEval::c_wrap_apply_proc(void * p)
+{
+	SchemeEval *self = (SchemeEval *) p;
+	SCM smob = self->do_apply_proc(self->_pproc, self->_hargs);
+	if (self->eval_error()) return self;
+	self->_retval = SchemeSmob::scm_to_protom(smob);
+	return self;
+}
+
 /* ============================================================== */
 
 // A pool of scheme evaluators, sitting hot and ready to go.
@@ -1108,6 +1218,21 @@ static void return_to_pool(SchemeEval* ev)
 	pool.push(ev);
 }
 
+/// Create `nevals` evaluators, and place them in the pool, so that
+/// threads calling get_evaluator() for the first time do not have to
+/// pay for creating and initializing one.  Useful when many worker
+/// threads will be running short scheme snippets, e.g. from
+/// GroundedSchemaNodes.
+void SchemeEval::reserve(size_t nevals)
+{
+	for (size_t i=0; i<nevals; i++)
+	{
+		SchemeEval* ev = new SchemeEval();
+		std::lock_guard<std::mutex> lock(pool_mtx);
+		pool.push(ev);
+	}
+}
+
 /// Return evaluator, for this thread and atomspace combination.
 /// If called with NULL, it will use the current atomspace for
 /// this thread.
@@ -118,6 +118,12 @@ class SchemeEval : public GenericEval
 		SCM do_apply_scm(const std::string& func, const Handle& varargs);
 		static void * c_wrap_apply_v(void *);
 
+		// Apply pre-resolved procedure to arguments
+		SCM _pproc;
+		SCM do_apply_proc(SCM, const Handle& varargs);
+		static void * c_wrap_apply_proc(void *);
+		static void * c_wrap_intern_proc(void *);
+
 		// Exception and error handling stuff
 		SCM _scm_error_string;
 		std::string _error_msg;
@@ -150,6 +156,9 @@ class SchemeEval : public GenericEval
 		// Return per-thread, per-atomspace singleton
 		static SchemeEval* get_evaluator(AtomSpace* = NULL);
 
+		// Pre-create evaluators for use by get_evaluator()
+		static void reserve(size_t);
+
 		// The async-output interface.
 		void begin_eval(void);
 		void eval_expr(const std::string&);
@@ -184,6 +193,15 @@ class SchemeEval : public GenericEval
 		TruthValuePtr apply_tv(const std::string& func, Handle varargs) {
 			return TruthValueCast(apply_v(func, varargs)); }
 
+		// Make a symbol of the procedure name, so that it can be
+		// applied without re-parsing the name. The symbol is protected
+		// from garbage collection, and is meant to be cached.
+		virtual SCM intern_proc(const std::string& func);
+
+		// Apply the procedure named by a symbol from intern_proc(),
+		// as found in the current module.
+		virtual ValuePtr apply_proc(SCM sym, Handle varargs);
+
 		// Nested invocations
 		bool recursing(void) { return _in_eval; }
 };
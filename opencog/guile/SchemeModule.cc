@@ -40,6 +40,13 @@ FunctionWrap::FunctionWrap(ValuePtr (p)(AtomSpace*, const Handle&),
 	define_scheme_primitive(_name, &FunctionWrap::as_wrapper_v_h, this, modname);
 }
 
+FunctionWrap::FunctionWrap(ValuePtr (p)(AtomSpace*, const Handle&, size_t),
+                           const char* funcname, const char* modname)
+	: _proto_ahz(p), _name(funcname)
+{
+	define_scheme_primitive(_name, &FunctionWrap::as_wrapper_v_hz, this, modname);
+}
+
 Handle FunctionWrap::as_wrapper_h_h(Handle h)
 {
 	// XXX we should also allow opt-args to be a list of handles
@@ -68,6 +75,13 @@ ValuePtr FunctionWrap::as_wrapper_v_h(Handle h)
 	return _proto_ah(as, h);
 }
 
+ValuePtr FunctionWrap::as_wrapper_v_hz(Handle h, size_t sz)
+{
+	// XXX we should also allow opt-args to be a list of handles
+	AtomSpace *as = SchemeSmob::ss_get_env_as(_name);
+	return _proto_ahz(as, h, sz);
+}
+
 // ========================================================
 
 ModuleWrap::ModuleWrap(const char* m) :
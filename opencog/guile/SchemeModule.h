@@ -36,7 +36,9 @@ class FunctionWrap
 		TruthValuePtr as_wrapper_p_h(Handle);
 
 		ValuePtr (*_proto_ah)(AtomSpace*, const Handle&);
+		ValuePtr (*_proto_ahz)(AtomSpace*, const Handle&, size_t);
 		ValuePtr as_wrapper_v_h(Handle);
+		ValuePtr as_wrapper_v_hz(Handle, size_t);
 
 		const char *_name;  // scheme name of the c++ function.
 	public:
@@ -48,6 +50,8 @@ class FunctionWrap
 		             const char*, const char*);
 		FunctionWrap(ValuePtr (*)(AtomSpace*, const Handle&),
 		             const char*, const char*);
+		FunctionWrap(ValuePtr (*)(AtomSpace*, const Handle&, size_t),
+		             const char*, const char*);
 };
 
 class ModuleWrap
@@ -270,10 +270,13 @@ void SchemeSmob::register_procs()
 	// Value API
 	register_proc("cog-value->list",       1, 0, 0, C(ss_value_to_list));
 	register_proc("cog-value-ref",         2, 0, 0, C(ss_value_ref));
+	register_proc("cog-stream-next",       1, 0, 0, C(ss_stream_next));
+	register_proc("cog-stream-halt!",      1, 0, 0, C(ss_stream_halt));
 
 	// Generic property setter on atoms
 	register_proc("cog-set-value!",        3, 0, 0, C(ss_set_value));
 	register_proc("cog-set-values!",       2, 0, 0, C(ss_set_values));
+	register_proc("cog-bulk-set-value!",   3, 0, 0, C(ss_bulk_set_value));
 
 	// TV property setters on atoms
 	register_proc("cog-set-tv!",           2, 0, 0, C(ss_set_tv));
@@ -295,6 +298,7 @@ void SchemeSmob::register_procs()
 	register_proc("cog-keys",              1, 0, 0, C(ss_keys));
 	register_proc("cog-keys->alist",       1, 0, 0, C(ss_keys_alist));
 	register_proc("cog-value",             2, 0, 0, C(ss_value));
+	register_proc("cog-bulk-value",        2, 0, 0, C(ss_bulk_value));
 	register_proc("cog-tv",                1, 0, 0, C(ss_tv));
 	register_proc("cog-atomspace",         0, 0, 1, C(ss_as));
 	register_proc("cog-as",                0, 0, 1, C(ss_as));
@@ -321,10 +325,21 @@ void SchemeSmob::register_procs()
 	register_proc("cog-atomspace-rw!",     0, 1, 0, C(ss_as_mark_readwrite));
 	register_proc("cog-atomspace-cow?",    0, 1, 0, C(ss_as_cow_p));
 	register_proc("cog-atomspace-cow!",    1, 1, 0, C(ss_as_mark_cow));
+	register_proc("cog-atomspace-merge!",  0, 1, 0, C(ss_as_merge));
 
 	// Taking AtomSpace as optional argument
 	register_proc("cog-count-atoms",       1, 1, 0, C(ss_count));
 	register_proc("cog-map-type",          2, 1, 0, C(ss_map_type));
+	register_proc("cog-partition-type",    1, 2, 0, C(ss_partition_type));
+	register_proc("cog-type-value-count",  2, 1, 0, C(ss_type_value_count));
+	register_proc("cog-type-value-sum",    3, 1, 0, C(ss_type_value_sum));
+	register_proc("cog-type-value-filter", 5, 1, 0, C(ss_type_value_filter));
+	register_proc("cog-type-value-collect", 3, 1, 0, C(ss_type_value_collect));
+	register_proc("cog-add-name-index!",   1, 1, 0, C(ss_add_name_index));
+	register_proc("cog-remove-name-index!", 1, 1, 0, C(ss_remove_name_index));
+	register_proc("cog-nodes-by-prefix",   2, 1, 0, C(ss_nodes_by_prefix));
+	register_proc("cog-nodes-by-substring", 2, 1, 0, C(ss_nodes_by_substring));
+	register_proc("cog-nodes-by-name",     1, 1, 0, C(ss_nodes_by_name));
 
 	// Value types
 	register_proc("cog-get-types",         0, 0, 0, C(ss_get_types));
@@ -107,10 +107,15 @@ private:
 	static SCM ss_value_to_list(SCM);
 	static SCM ss_value_ref(SCM, SCM);
 
+	// Read from a QueueValue, one value at a time
+	static SCM ss_stream_next(SCM);
+	static SCM ss_stream_halt(SCM);
+
 	// Property setters on atoms
 	static SCM ss_set_tv(SCM, SCM);
 	static SCM ss_set_value(SCM, SCM, SCM);
 	static SCM ss_set_values(SCM, SCM);
+	static SCM ss_bulk_set_value(SCM, SCM, SCM);
 	static SCM ss_inc_count(SCM, SCM);
 	static SCM ss_inc_value(SCM, SCM, SCM, SCM);
 
@@ -126,6 +131,7 @@ private:
 	static SCM ss_keys(SCM);
 	static SCM ss_keys_alist(SCM);
 	static SCM ss_value(SCM, SCM);
+	static SCM ss_bulk_value(SCM, SCM);
 	static SCM ss_incoming_set(SCM);
 	static SCM ss_incoming_size(SCM);
 	static SCM ss_incoming_by_type(SCM, SCM);
@@ -136,11 +142,21 @@ private:
 
 	// Type query functions
 	static SCM ss_map_type(SCM, SCM, SCM);
+	static SCM ss_partition_type(SCM, SCM, SCM);
 	static SCM ss_get_types(void);
 	static SCM ss_get_type(SCM);
 	static SCM ss_get_subtypes(SCM);
 	static SCM ss_subtype_p(SCM, SCM);
 	static SCM ss_count(SCM, SCM);
+	static SCM ss_type_value_count(SCM, SCM, SCM);
+	static SCM ss_type_value_sum(SCM, SCM, SCM, SCM);
+	static SCM ss_type_value_filter(SCM, SCM, SCM, SCM, SCM, SCM);
+	static SCM ss_type_value_collect(SCM, SCM, SCM, SCM);
+	static SCM ss_add_name_index(SCM, SCM);
+	static SCM ss_remove_name_index(SCM, SCM);
+	static SCM ss_nodes_by_prefix(SCM, SCM, SCM);
+	static SCM ss_nodes_by_substring(SCM, SCM, SCM);
+	static SCM ss_nodes_by_name(SCM, SCM);
 
 	// Truth values
 	static SCM ss_tv_get_mean(SCM);
@@ -162,6 +178,7 @@ private:
 	static SCM ss_as_readonly_p(SCM);
 	static SCM ss_as_mark_cow(SCM, SCM);
 	static SCM ss_as_cow_p(SCM);
+	static SCM ss_as_merge(SCM);
 	static SCM make_as(AtomSpace *);
 	static void release_as(AtomSpace *);
 	static AtomSpace* ss_to_atomspace(SCM);
@@ -315,6 +315,28 @@ SCM SchemeSmob::ss_as_mark_cow(SCM scow, SCM sas)
 	return SCM_BOOL_T;
 }
 
+/* ============================================================== */
+/**
+ * Merge the contents of the atomspace into its parent.
+ */
+SCM SchemeSmob::ss_as_merge(SCM sas)
+{
+	AtomSpace* as = ss_to_atomspace(sas);
+	if (nullptr == as) as = ss_get_env_as("cog-atomspace-merge!");
+
+	try
+	{
+		as->merge_back();
+	}
+	catch (const std::exception& ex)
+	{
+		throw_exception(ex, "cog-atomspace-merge!", sas);
+	}
+
+	scm_remember_upto_here_1(sas);
+	return SCM_BOOL_T;
+}
+
 /* ============================================================== */
 /**
  * Clear the atomspace
@@ -6,6 +6,7 @@
  * Copyright (c) 2008,2009 Linas Vepstas <linas@linas.org>
  */
 
+#include <mutex>
 #include <vector>
 
 #include <cstddef>
@@ -13,6 +14,7 @@
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/value/Value.h>
+#include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/core/FindUtils.h>
 #include <opencog/atoms/truthvalue/CountTruthValue.h>
@@ -401,6 +403,37 @@ SCM SchemeSmob::ss_map_type (SCM proc, SCM stype, SCM aspace)
 	return SCM_BOOL_F;
 }
 
+/**
+ * Return a list of lists of all of the atoms of the indicated type,
+ * cut up into about nparts parts, for handing out to threads.
+ */
+SCM SchemeSmob::ss_partition_type (SCM stype, SCM snparts, SCM aspace)
+{
+	Type t = verify_type (stype, "cog-partition-type", 1);
+
+	size_t nparts = 0;
+	if (scm_is_integer(snparts))
+		nparts = verify_size(snparts, "cog-partition-type", 2);
+
+	AtomSpace* atomspace = ss_to_atomspace(aspace);
+	if (nullptr == atomspace)
+		atomspace = ss_get_env_as("cog-partition-type");
+
+	std::vector<HandleSeq> parts;
+	atomspace->get_partitions_by_type(parts, t, false, nparts);
+
+	SCM list = SCM_EOL;
+	for (const HandleSeq& part : parts)
+	{
+		SCM sub = SCM_EOL;
+		for (const Handle& h : part)
+			sub = scm_cons(handle_to_scm(h), sub);
+		list = scm_cons(sub, list);
+	}
+
+	return list;
+}
+
 /* ============================================================== */
 
 /**
@@ -519,6 +552,251 @@ SCM SchemeSmob::ss_count (SCM stype, SCM aspace)
 	return scm_from_size_t(cnt);
 }
 
+/* ============================================================== */
+/*
+ * Bulk reductions over all atoms of a given type.
+ *
+ * The functions below walk over the atoms of a type entirely in C++,
+ * in parallel, and hand a single result back to guile. This avoids
+ * creating one smob per atom, which is what makes `cog-map-type` and
+ * `cog-get-atoms` slow on large atomspaces. Only FloatValues (and
+ * thus TruthValues) are looked at; atoms without a FloatValue on the
+ * key, or with one that is too short, are skipped.
+ */
+
+/// Place the index'th entry of the FloatValue at key into d.
+/// Return false if there is no such entry.
+static bool get_float(const Handle& h, const Handle& key,
+                      size_t index, double& d)
+{
+	ValuePtr vp(h->getValue(key));
+	if (nullptr == vp or not nameserver().isA(vp->get_type(), FLOAT_VALUE))
+		return false;
+
+	const std::vector<double>& v = FloatValueCast(vp)->value();
+	if (v.size() <= index) return false;
+	d = v[index];
+	return true;
+}
+
+/**
+ * Return a count of the number of atoms of the indicated type
+ * that have a value on the indicated key.
+ */
+SCM SchemeSmob::ss_type_value_count (SCM stype, SCM skey, SCM aspace)
+{
+	Type t = verify_type(stype, "cog-type-value-count", 1);
+	Handle key(verify_handle(skey, "cog-type-value-count", 2));
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-type-value-count");
+
+	size_t cnt = as->map_reduce_by_type<size_t>(t, false, 0,
+		[&](const Handle& h)->size_t {
+			return h->getValue(key) ? 1 : 0;
+		},
+		[](size_t a, size_t b)->size_t { return a + b; });
+
+	return scm_from_size_t(cnt);
+}
+
+/**
+ * Return the sum of the index'th entry of the FloatValue located at
+ * key, taken over all atoms of the indicated type.
+ */
+SCM SchemeSmob::ss_type_value_sum (SCM stype, SCM skey, SCM sindex,
+                                   SCM aspace)
+{
+	Type t = verify_type(stype, "cog-type-value-sum", 1);
+	Handle key(verify_handle(skey, "cog-type-value-sum", 2));
+	size_t index = verify_size(sindex, "cog-type-value-sum", 3);
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-type-value-sum");
+
+	double sum = as->map_reduce_by_type<double>(t, false, 0.0,
+		[&](const Handle& h)->double {
+			double d;
+			if (not get_float(h, key, index, d)) return 0.0;
+			return d;
+		},
+		[](double a, double b)->double { return a + b; });
+
+	return scm_from_double(sum);
+}
+
+/**
+ * Return a list of the atoms of the indicated type for which the
+ * index'th entry of the FloatValue at key lies in the half-open
+ * interval [lo, hi).  Use +inf.0 or -inf.0 for one-sided bounds.
+ */
+SCM SchemeSmob::ss_type_value_filter (SCM stype, SCM skey, SCM sindex,
+                                      SCM slo, SCM shi, SCM aspace)
+{
+	Type t = verify_type(stype, "cog-type-value-filter", 1);
+	Handle key(verify_handle(skey, "cog-type-value-filter", 2));
+	size_t index = verify_size(sindex, "cog-type-value-filter", 3);
+	double lo = verify_real(slo, "cog-type-value-filter", 4);
+	double hi = verify_real(shi, "cog-type-value-filter", 5);
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-type-value-filter");
+
+	std::mutex mtx;
+	HandleSeq hits;
+	as->foreach_parallel_by_type(
+		[&](const Handle& h)->void {
+			double d;
+			if (not get_float(h, key, index, d)) return;
+			if (d < lo or hi <= d) return;
+			std::lock_guard<std::mutex> lck(mtx);
+			hits.push_back(h);
+		}, t);
+
+	SCM list = SCM_EOL;
+	for (const Handle& h : hits)
+		list = scm_cons(handle_to_scm(h), list);
+
+	return list;
+}
+
+/**
+ * Return a FloatValue holding the index'th entry of the FloatValue
+ * at key, for every atom of the indicated type that has one. The
+ * order of the entries is not specified.
+ */
+SCM SchemeSmob::ss_type_value_collect (SCM stype, SCM skey, SCM sindex,
+                                       SCM aspace)
+{
+	Type t = verify_type(stype, "cog-type-value-collect", 1);
+	Handle key(verify_handle(skey, "cog-type-value-collect", 2));
+	size_t index = verify_size(sindex, "cog-type-value-collect", 3);
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-type-value-collect");
+
+	std::mutex mtx;
+	std::vector<double> vals;
+	vals.reserve(as->get_num_atoms_of_type(t));
+	as->foreach_parallel_by_type(
+		[&](const Handle& h)->void {
+			double d;
+			if (not get_float(h, key, index, d)) return;
+			std::lock_guard<std::mutex> lck(mtx);
+			vals.push_back(d);
+		}, t);
+
+	return protom_to_scm(createFloatValue(std::move(vals)));
+}
+
+/* ============================================================== */
+/*
+ * Node lookup by name.
+ */
+
+/**
+ * Start maintaining a sorted index of the names of all nodes of the
+ * indicated type.
+ */
+SCM SchemeSmob::ss_add_name_index (SCM stype, SCM aspace)
+{
+	Type t = verify_type(stype, "cog-add-name-index!", 1);
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-add-name-index!");
+
+	try
+	{
+		as->add_name_index(t);
+	}
+	catch (const std::exception& ex)
+	{
+		throw_exception(ex, "cog-add-name-index!", stype);
+	}
+	return SCM_BOOL_T;
+}
+
+SCM SchemeSmob::ss_remove_name_index (SCM stype, SCM aspace)
+{
+	Type t = verify_type(stype, "cog-remove-name-index!", 1);
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-remove-name-index!");
+
+	as->remove_name_index(t);
+	return SCM_BOOL_T;
+}
+
+/**
+ * Return a list of all nodes of the indicated type whose name
+ * starts with the given prefix.
+ */
+SCM SchemeSmob::ss_nodes_by_prefix (SCM stype, SCM sprefix, SCM aspace)
+{
+	Type t = verify_type(stype, "cog-nodes-by-prefix", 1);
+	std::string prefix(verify_string(sprefix, "cog-nodes-by-prefix", 2));
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-nodes-by-prefix");
+
+	HandleSeq hs(as->get_nodes_by_prefix(t, prefix));
+
+	SCM list = SCM_EOL;
+	for (auto it = hs.rbegin(); it != hs.rend(); it++)
+		list = scm_cons(handle_to_scm(*it), list);
+
+	return list;
+}
+
+/**
+ * Return a list of all nodes of the indicated type whose name
+ * contains the given string.
+ */
+SCM SchemeSmob::ss_nodes_by_substring (SCM stype, SCM ssub, SCM aspace)
+{
+	Type t = verify_type(stype, "cog-nodes-by-substring", 1);
+	std::string sub(verify_string(ssub, "cog-nodes-by-substring", 2));
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-nodes-by-substring");
+
+	HandleSeq hs(as->get_nodes_by_substring(t, sub));
+
+	SCM list = SCM_EOL;
+	for (auto it = hs.rbegin(); it != hs.rend(); it++)
+		list = scm_cons(handle_to_scm(*it), list);
+
+	return list;
+}
+
+/**
+ * Return a list of all nodes, of any type, with the given name.
+ */
+SCM SchemeSmob::ss_nodes_by_name (SCM sname, SCM aspace)
+{
+	std::string name(verify_string(sname, "cog-nodes-by-name", 1));
+
+	AtomSpace* as = ss_to_atomspace(aspace);
+	if (nullptr == as)
+		as = ss_get_env_as("cog-nodes-by-name");
+
+	HandleSeq hs(as->get_nodes_by_name(name));
+
+	SCM list = SCM_EOL;
+	for (auto it = hs.rbegin(); it != hs.rend(); it++)
+		list = scm_cons(handle_to_scm(*it), list);
+
+	return list;
+}
+
 SCM SchemeSmob::ss_get_free_variables(SCM satom)
 {
 	Handle h = verify_handle(satom, "cog-free-variables");
@@ -12,6 +12,7 @@
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/QueueValue.h>
 #include <opencog/atoms/value/StringValue.h>
 #include <opencog/atoms/value/RandomStream.h>
 #include <opencog/atoms/base/Atom.h>
@@ -379,6 +380,73 @@ SCM SchemeSmob::ss_value (SCM satom, SCM skey)
 	return SCM_EOL;
 }
 
+/**
+ * Return a list of the values at KEY, one for each atom in the list.
+ * Atoms without a value at KEY give #f.
+ */
+SCM SchemeSmob::ss_bulk_value (SCM satoms, SCM skey)
+{
+	HandleSeq atoms(verify_handle_list(satoms, "cog-bulk-value", 1));
+	Handle key(verify_handle(skey, "cog-bulk-value", 2));
+	AtomSpace* as = ss_get_env_as("cog-bulk-value");
+
+	ValueSeq vals;
+	try
+	{
+		vals = as->get_values(atoms, key);
+	}
+	catch (const std::exception& ex)
+	{
+		throw_exception(ex, "cog-bulk-value", scm_cons(satoms, skey));
+	}
+
+	SCM rv = SCM_EOL;
+	for (auto it = vals.rbegin(); it != vals.rend(); it++)
+		rv = scm_cons(protom_to_scm(*it), rv);
+	return rv;
+}
+
+/**
+ * Set the values at KEY, one on each atom. The value list must be
+ * just as long as the atom list; a value of #f removes the key.
+ * Returns the list of atoms that were changed; these differ from
+ * the given atoms only if the atomspace is copy-on-write.
+ */
+SCM SchemeSmob::ss_bulk_set_value (SCM satoms, SCM skey, SCM svalues)
+{
+	HandleSeq atoms(verify_handle_list(satoms, "cog-bulk-set-value!", 1));
+	Handle key(verify_handle(skey, "cog-bulk-set-value!", 2));
+	AtomSpace* as = ss_get_env_as("cog-bulk-set-value!");
+
+	if (not scm_is_true(scm_list_p(svalues)))
+		scm_wrong_type_arg_msg("cog-bulk-set-value!", 3, svalues, "list of values");
+
+	ValueSeq vals;
+	for (SCM sl = svalues; scm_is_pair(sl); sl = SCM_CDR(sl))
+	{
+		SCM sv = SCM_CAR(sl);
+		if (scm_is_false(sv) or scm_is_null(sv))
+			vals.emplace_back(nullptr);
+		else
+			vals.emplace_back(verify_protom(sv, "cog-bulk-set-value!", 3));
+	}
+
+	HandleSeq changed;
+	try
+	{
+		changed = as->set_values(atoms, key, vals);
+	}
+	catch (const std::exception& ex)
+	{
+		throw_exception(ex, "cog-bulk-set-value!", satoms);
+	}
+
+	SCM rv = SCM_EOL;
+	for (auto it = changed.rbegin(); it != changed.rend(); it++)
+		rv = scm_cons(handle_to_scm(*it), rv);
+	return rv;
+}
+
 /** Return all of the keys on the atom */
 SCM SchemeSmob::ss_keys (SCM satom)
 {
@@ -547,4 +615,53 @@ SCM SchemeSmob::ss_value_ref (SCM svalue, SCM sindex)
 	return SCM_EOL;
 }
 
+/* ============================================================== */
+
+static QueueValuePtr verify_queue(ValuePtr pa, SCM svalue,
+                                  const char* subrname)
+{
+	QueueValuePtr qv(QueueValueCast(pa));
+	if (nullptr == qv)
+		scm_wrong_type_arg_msg(subrname, 1, svalue, "QueueValue");
+	return qv;
+}
+
+struct StreamRead
+{
+	QueueValuePtr qv;
+	ValuePtr val;
+	bool got;
+};
+
+static void* stream_read(void* data)
+{
+	StreamRead* sr = (StreamRead*) data;
+	sr->got = sr->qv->next(sr->val);
+	return nullptr;
+}
+
+/**
+ * Return the next value in the queue, waiting for it if need be.
+ * Return #f once the queue is closed and empty.
+ */
+SCM SchemeSmob::ss_stream_next(SCM svalue)
+{
+	ValuePtr pa(verify_protom(svalue, "cog-stream-next"));
+	StreamRead sr;
+	sr.qv = verify_queue(pa, svalue, "cog-stream-next");
+
+	// Leave guile while waiting, so that the writer, and guile GC
+	// in other threads, can carry on.
+	scm_without_guile(stream_read, &sr);
+	if (not sr.got) return SCM_BOOL_F;
+	return protom_to_scm(sr.val);
+}
+
+SCM SchemeSmob::ss_stream_halt(SCM svalue)
+{
+	ValuePtr pa(verify_protom(svalue, "cog-stream-halt!"));
+	verify_queue(pa, svalue, "cog-stream-halt!")->halt();
+	return SCM_UNSPECIFIED;
+}
+
 /* ===================== END OF FILE ============================ */
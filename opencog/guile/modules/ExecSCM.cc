@@ -31,6 +31,7 @@ void opencog_exec_init(void);
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/execution/EvaluationLink.h>
 #include <opencog/atoms/execution/Instantiator.h>
+#include <opencog/atoms/pattern/QueryLink.h>
 #include <opencog/atoms/reduct/FoldLink.h>
 #include <opencog/guile/SchemeModule.h>
 
@@ -58,6 +59,20 @@ static ValuePtr ss_execute(AtomSpace* atomspace, const Handle& h)
 	return pap;
 }
 
+/**
+ * cog-execute-stream! runs a QueryLink in the background, returning
+ * a queue that holds at most `capacity` unread results.
+ */
+static ValuePtr ss_execute_stream(AtomSpace* atomspace, const Handle& h,
+                                  size_t capacity)
+{
+	QueryLinkPtr qlp(QueryLinkCast(h));
+	if (nullptr == qlp)
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting a QueryLink, got %s", h->to_short_string().c_str());
+	return qlp->execute_stream(atomspace, capacity);
+}
+
 /**
  * cog-evaluate! evaluates an EvaluationLink with a GPN in it.
  */
@@ -90,6 +105,9 @@ void ExecSCM::init(void)
 
 	_binders->push_back(new FunctionWrap(ss_evaluate,
 	                   "cog-evaluate!", "exec"));
+
+	_binders->push_back(new FunctionWrap(ss_execute_stream,
+	                   "cog-execute-stream!", "exec"));
 }
 
 ExecSCM::~ExecSCM()
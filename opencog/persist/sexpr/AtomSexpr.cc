@@ -23,8 +23,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <deque>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/base/Link.h>
@@ -36,41 +39,67 @@
 
 using namespace opencog;
 
+static inline bool is_space(char c)
+{
+	return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+}
+
+/// Return a short piece of `s`, starting at `l`, for error messages.
+/// The string might be an entire file, so don't print all of it.
+static std::string excerpt(std::string_view s, size_t l, size_t r)
+{
+	static const size_t MAX_EXCERPT = 120;
+	if (s.size() < l) l = s.size();
+	if (r < l) r = l;
+	return std::string(s.substr(l, std::min(r - l + 1, MAX_EXCERPT)));
+}
+
 /// Extract s-expression. Given a string `s`, update the `l` and `r`
 /// values so that `l` points at the next open-parenthesis (left paren)
 /// and `r` points at the matching close-paren.  Returns parenthesis
-/// count. If zero, the parens match. If non-zero, then `r` points
-/// at the first non-valid character in the string (e.g. comment char).
-int Sexpr::get_next_expr(const std::string& s, size_t& l, size_t& r,
+/// count. If zero, the parens match. If non-zero, then the expression
+/// is not finished before `r`, and `r` is left unchanged.
+///
+/// Whitespace and comments before the expression are skipped, as are
+/// comments inside of it. A comment runs from a semicolon to the end
+/// of the line.
+int Sexpr::get_next_expr(std::string_view s, size_t& l, size_t& r,
                          size_t line_cnt)
 {
-	// Advance past whitespace.
-	while (l < r and (s[l] == ' ' or s[l] == '\t' or s[l] == '\n')) l++;
+	// Advance past whitespace and comments.
+	while (l < r)
+	{
+		if (is_space(s[l])) l++;
+		else if (s[l] == ';')
+			while (l < r and s[l] != '\n') l++;
+		else break;
+	}
 	if (l == r) return 0;
 
-	// Ignore comment lines.
-	if (s[l] == ';') { r = l; return 1; }
-
 	if (s[l] != '(')
 		throw std::runtime_error(
 			"Syntax error at line " + std::to_string(line_cnt) +
-			" Unexpected text: >>" + s.substr(l) + "<<");
+			" Unexpected text: >>" + excerpt(s, l, r) + "<<");
 
 	size_t p = l;
 	int count = 1;
 	bool quoted = false;
-	do {
-		p++;
-		if (s[p] == '"')
+	while (0 < count and ++p < r)
+	{
+		char c = s[p];
+		if (quoted)
 		{
-			if (0 < p and s[p - 1] != '\\')
-				quoted = !quoted;
+			// Step over escaped quotes and backslashes.
+			if (c == '\\' and p + 1 < r) p++;
+			else if (c == '"') quoted = false;
+			continue;
 		}
-		else if (quoted) continue;
-		else if (s[p] == '(') count++;
-		else if (s[p] == ')') count--;
-		else if (s[p] == ';') break;      // comments!
-	} while (p < r and count > 0);
+		if (c == '"') quoted = true;
+		else if (c == '(') count++;
+		else if (c == ')') count--;
+		else if (c == ';')
+			while (p + 1 < r and s[p + 1] != '\n') p++;
+	}
 
 	r = p;
 	return count;
@@ -79,21 +108,21 @@ int Sexpr::get_next_expr(const std::string& s, size_t& l, size_t& r,
 /// Extracts link or node type. Given the string `s`, this updates
 /// the `l` and `r` values such that `l` points at the first
 /// non-whitespace character of the name, and `r` points at the last.
-static void get_typename(const std::string& s, size_t& l, size_t& r,
+static void get_typename(std::string_view s, size_t& l, size_t& r,
                          size_t line_cnt)
 {
 	// Advance past whitespace.
-	while (l < r and (s[l] == ' ' or s[l] == '\t' or s[l] == '\n')) l++;
+	while (l < r and is_space(s[l])) l++;
 
 	if (s[l] != '(')
 		throw std::runtime_error(
 			"Syntax error at line " + std::to_string(line_cnt) +
-			" Unexpected content: >>" + s.substr(l, r-l+1) + "<< in " + s);
+			" Unexpected content: >>" + excerpt(s, l, r) + "<<");
 
-	// Advance until whitespace. Might be fast to use strtok?
+	// Advance until whitespace.
 	l++;
 	size_t p = l;
-	for (; l < r and s[p] != '(' and s[p] != ' ' and s[p] != '\t' and s[p] != '\n'; p++);
+	for (; p < r and s[p] != '(' and not is_space(s[p]); p++);
 	r = p;
 }
 
@@ -107,11 +136,11 @@ static void get_typename(const std::string& s, size_t& l, size_t& r,
 /// If the node is a Type node, then `l` points at the first
 /// non-whitespace character of the type name and `r` points to the next
 /// opening parenthesis.
-static void get_node_name(const std::string& s, size_t& l, size_t& r,
+static void get_node_name(std::string_view s, size_t& l, size_t& r,
                           size_t line_cnt, bool typeNode = false)
 {
 	// Advance past whitespace.
-	while (l < r and (s[l] == ' ' or s[l] == '\t' or s[l] == '\n')) l++;
+	while (l < r and is_space(s[l])) l++;
 
 	// Scheme strings start and end with double-quote.
 	// Scheme symbols start with single-quote.
@@ -121,33 +150,78 @@ static void get_node_name(const std::string& s, size_t& l, size_t& r,
 	else if (not typeNode and s[l] != '"')
 		throw std::runtime_error(
 			"Syntax error at line " + std::to_string(line_cnt) +
-			" Unexpected content: >>" + s.substr(l, r-l+1) + "<< in " + s);
+			" Unexpected content: >>" + excerpt(s, l, r) + "<<");
 
 	l++;
 	size_t p = l;
 	if (scm_symbol)
-		for (; p < r and (s[p] != '(' or s[p] != ' ' or s[p] != '\t' or s[p] != '\n'); p++);
+		for (; p < r and s[p] != '(' and s[p] != ')' and not is_space(s[p]); p++);
 	else
-		for (; p < r and (s[p] != '"' or ((0 < p) and (s[p - 1] == '\\'))); p++);
+		for (; p < r and s[p] != '"'; p++)
+			if (s[p] == '\\') p++;
+	if (r < p) p = r;
 	r = p;
 }
 
+
+/// Undo the escaping of quotes and backslashes in a node name; any
+/// other backslash is kept as a part of the name.
+static std::string unescape(std::string_view s)
+{
+	if (std::string_view::npos == s.find('\\')) return std::string(s);
+
+	std::string name;
+	name.reserve(s.size());
+	for (size_t p = 0; p < s.size(); p++)
+	{
+		if ('\\' == s[p] and p + 1 < s.size() and
+		    ('"' == s[p+1] or '\\' == s[p+1])) p++;
+		name += s[p];
+	}
+	return name;
+}
+
 /// Extract SimpleTruthValue and return that, else throw an error.
-static TruthValuePtr get_stv(const std::string& s,
+static TruthValuePtr get_stv(std::string_view s,
                              size_t l, size_t r, size_t line_cnt)
 {
 	if (s.compare(l, 5, "(stv "))
 		throw std::runtime_error(
 				"Syntax error at line " + std::to_string(line_cnt) +
-				" Unsupported markup: " + s.substr(l, r-l+1) +
-				" in expr: " + s);
+				" Unsupported markup: " + excerpt(s, l, r));
 
 	return createSimpleTruthValue(
-				NumberNode::to_vector(s.substr(l+4, r-l-4)));
+				NumberNode::to_vector(std::string(s.substr(l+4, r-l-4))));
 }
 
 static NameServer& namer = nameserver();
 
+/// Look up atom types by name, without making a std::string out of
+/// each name. The same few type names are seen over and over again;
+/// this avoids the allocation and the NameServer lock for each one.
+static Type get_type(std::string_view stype)
+{
+	struct TypeCache
+	{
+		std::unordered_map<std::string_view, Type> types;
+		std::deque<std::string> names;  // Owns the keys in `types`
+	};
+	static thread_local TypeCache cache;
+
+	auto it = cache.types.find(stype);
+	if (cache.types.end() != it) return it->second;
+
+	cache.names.emplace_back(stype);
+	Type t = namer.getType(cache.names.back());
+	if (NOTYPE == t)
+	{
+		cache.names.pop_back();
+		return t;
+	}
+	cache.types.emplace(cache.names.back(), t);
+	return t;
+}
+
 /// Convert an Atomese S-expression into a C++ Atom.
 /// For example: `(Concept "foobar")`  or
 /// `(Evaluation (Predicate "blort") (List (Concept "foo") (Concept "bar")))`
@@ -157,18 +231,18 @@ static NameServer& namer = nameserver();
 /// as a hint for the end of the expression. The `line_count` is an
 /// optional argument for printing file line-numbers, in case of error.
 ///
-Handle Sexpr::decode_atom(const std::string& s,
+Handle Sexpr::decode_atom(std::string_view s,
                           size_t l, size_t r, size_t line_cnt)
 {
 	size_t l1 = l, r1 = r;
 	get_typename(s, l1, r1, line_cnt);
-	const std::string stype = s.substr(l1, r1-l1);
+	std::string_view stype = s.substr(l1, r1-l1);
 
-	opencog::Type atype = namer.getType(stype);
+	opencog::Type atype = get_type(stype);
 	if (atype == opencog::NOTYPE)
 		throw std::runtime_error(
 			"Syntax error at line " + std::to_string(line_cnt) +
-			" Unknown Atom type: " + stype);
+			" Unknown Atom type: " + std::string(stype));
 
 	l = r1;
 	if (namer.isLink(atype))
@@ -204,7 +278,7 @@ Handle Sexpr::decode_atom(const std::string& s,
 		l2 = r1;
 		if ('"' == s[l2]) l2++; // step past trailing quote.
 
-		const std::string name = s.substr(l1, r1-l1);
+		std::string name(unescape(s.substr(l1, r1-l1)));
 		Handle h(createNode(atype, std::move(name)));
 
 		// There might be an stv in the content. Handle it.
@@ -217,5 +291,5 @@ Handle Sexpr::decode_atom(const std::string& s,
 	}
 	throw std::runtime_error(
 		"Syntax error at line " + std::to_string(line_cnt) +
-		"Got a Value, not supported: " + s);
+		" Got a Value, not supported: " + excerpt(s, l, r));
 }
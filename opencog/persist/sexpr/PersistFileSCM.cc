@@ -38,6 +38,7 @@ private:
 	void init(void);
 
 	void load_file(const std::string&);
+	void dump_file(const std::string&);
 public:
 	PersistFileSCM(void);
 }; // class
@@ -76,6 +77,8 @@ void PersistFileSCM::init(void)
 {
 	define_scheme_primitive("load-file",
 	             &PersistFileSCM::load_file, this, "persist-file");
+	define_scheme_primitive("dump-file",
+	             &PersistFileSCM::dump_file, this, "persist-file");
 }
 
 // =====================================================================
@@ -86,6 +89,12 @@ void PersistFileSCM::load_file(const std::string & path)
 	opencog::load_file(path, *as);
 }
 
+void PersistFileSCM::dump_file(const std::string & path)
+{
+	AtomSpace *as = SchemeSmob::ss_get_env_as("dump-file");
+	opencog::dump_file(path, *as);
+}
+
 void opencog_persist_file_init(void)
 {
 	static PersistFileSCM patty;
@@ -24,6 +24,7 @@
 #define _SEXPR_ECODE_H
 
 #include <string>
+#include <string_view>
 #include <opencog/atoms/base/Handle.h>
 
 namespace opencog
@@ -55,10 +56,12 @@ public:
 	static ValuePtr decode_value(const std::string&, size_t&);
 	static void decode_alist(Handle&, const std::string&);
 
-	// API more suitable to very long, file-driven I/O.
-	static int get_next_expr(const std::string&,
+	// API more suitable to very long, file-driven I/O. The string
+	// can be a view of an entire file; nothing is copied out of it,
+	// other than the Node names.
+	static int get_next_expr(std::string_view,
                             size_t& l, size_t& r, size_t line_cnt);
-	static Handle decode_atom(const std::string& s,
+	static Handle decode_atom(std::string_view s,
                              size_t l, size_t r, size_t line_cnt);
 
 
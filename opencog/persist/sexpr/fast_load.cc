@@ -23,11 +23,19 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <fstream>
-#include <iostream>
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
+#include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atomspace/AtomSpace.h>
 
 #include "fast_load.h"
@@ -35,62 +43,156 @@
 
 using namespace opencog;
 
-static Handle parseStream(std::istream& in, AtomSpace& as)
+#define SETV "(cog-set-values! "
+
+/// Decode a value, or an atom used as a value, starting at `pos`,
+/// and move `pos` past it.
+static ValuePtr decode_value(const std::string& s, size_t& pos,
+                             AtomSpace& as)
+{
+    size_t e = s.find_first_of(" \t\n()", pos + 1);
+    Type t = nameserver().getType(s.substr(pos + 1, e - pos - 1));
+    if (NOTYPE == t or not nameserver().isA(t, ATOM))
+        return Sexpr::decode_value(s, pos);
+
+    Handle h(as.add_atom(Sexpr::decode_atom(s, pos)));
+    pos++;  // Past the closing paren.
+    return h;
+}
+
+/// Decode `(cog-set-values! ATOM (list (cons KEY VALUE) ...))`, as
+/// written by dump_file(), and set the values on the atom.
+static Handle load_values(std::string_view buf, size_t l, size_t r,
+                          size_t line_cnt, AtomSpace& as)
+{
+    size_t l1 = l + sizeof(SETV) - 1;
+    size_t r1 = r;
+    Sexpr::get_next_expr(buf, l1, r1, line_cnt);
+    Handle h(as.add_atom(Sexpr::decode_atom(buf, l1, r1, line_cnt)));
+
+    size_t l2 = r1 + 1;
+    size_t r2 = r;
+    if (Sexpr::get_next_expr(buf, l2, r2, line_cnt) or l2 == r2 or
+        buf.compare(l2, 6, "(list "))
+        throw std::runtime_error(
+            "Syntax error at line " + std::to_string(line_cnt) +
+            " Expecting a list of values");
+
+    // The values are few and short, compared to the whole buffer;
+    // copying them out keeps the value decoder simple.
+    std::string alist(buf.substr(l2, r2 - l2 + 1));
+    size_t pos = alist.find("(cons ");
+    while (std::string::npos != pos)
+    {
+        pos += 6;
+        Handle key(as.add_atom(Sexpr::decode_atom(alist, pos)));
+        pos = alist.find('(', pos + 1);
+        if (std::string::npos == pos)
+            throw std::runtime_error(
+                "Syntax error at line " + std::to_string(line_cnt) +
+                " Missing value for key " + key->to_short_string());
+
+        h->setValue(key, decode_value(alist, pos, as));
+        pos = alist.find("(cons ", pos);
+    }
+    return h;
+}
+
+/// Parse all of the expressions in the buffer, and add them to the
+/// AtomSpace. The buffer is never copied; the parser just walks
+/// through it, one expression at a time.
+static Handle parseBuffer(std::string_view buf, AtomSpace& as)
 {
     Handle h;
-    size_t expr_cnt = 0;
-    size_t line_cnt = 0;
+    size_t line_cnt = 1;
+    size_t counted = 0;  // Lines have been counted up to here.
+    size_t end = buf.size();
 
-    std::string expr;
-    while (!in.eof())
+    size_t l = 0;
+    while (l < end)
     {
-        std::string line;
-        std::getline(in, line);
-        line_cnt++;
-        expr += line;
-        while (true)
-        {
-            size_t l = 0;
-            size_t r = expr.length();
-
-            // Zippy the Pinhead says: Are we having fun yet?
-            int pcount = Sexpr::get_next_expr(expr, l, r, line_cnt);
-
-            // Trim away comments at end of line
-            if (0 < pcount)
-            {
-                expr = expr.substr(l, r - l);
-                break;
-            }
-
-            // Nothing to do.
-            if (l == r)
-                break;
-
-            expr_cnt++;
-            h = as.add_atom(Sexpr::decode_atom(expr, l, r, line_cnt));
-            expr = expr.substr(r + 1);
-        }
+        line_cnt += std::count(buf.begin() + counted, buf.begin() + l, '\n');
+        counted = l;
+
+        // Zippy the Pinhead says: Are we having fun yet?
+        size_t r = end;
+        int pcount = Sexpr::get_next_expr(buf, l, r, line_cnt);
+
+        // Nothing left but whitespace and comments; or an unfinished
+        // expression at the very end, which is ignored.
+        if (l == r or 0 < pcount)
+            break;
+
+        line_cnt += std::count(buf.begin() + counted, buf.begin() + l, '\n');
+        counted = l;
+
+        if (0 == buf.compare(l, sizeof(SETV) - 1, SETV))
+            h = load_values(buf, l, r, line_cnt, as);
+        else
+            h = as.add_atom(Sexpr::decode_atom(buf, l, r, line_cnt));
+        l = r + 1;
     }
 
     return h;
 }
 
+namespace {
+
+/// Read-only memory map of a whole file, unmapped when done.
+struct MappedFile
+{
+    void* addr = MAP_FAILED;
+    size_t len = 0;
+
+    MappedFile(int fd)
+    {
+        struct stat st;
+        if (0 != fstat(fd, &st) or not S_ISREG(st.st_mode) or 0 == st.st_size)
+            return;
+        len = st.st_size;
+        addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED != addr)
+            madvise(addr, len, MADV_SEQUENTIAL);
+    }
+    ~MappedFile()
+    {
+        if (MAP_FAILED != addr) munmap(addr, len);
+    }
+    bool ok() const { return MAP_FAILED != addr; }
+    std::string_view view() const
+    {
+        return std::string_view((const char*) addr, len);
+    }
+};
+
+}
+
 /// load_file -- load the given file into the given AtomSpace.
 void opencog::load_file(const std::string& fname, AtomSpace& as)
 {
-    std::ifstream f(fname);
-    if (not f.is_open())
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
        throw std::runtime_error("Cannot find file >>" + fname + "<<");
 
-    parseStream(f, as);
-    
-    f.close();
+    // The mapping stays valid after the descriptor is closed.
+    MappedFile mf(fd);
+    close(fd);
+
+    if (mf.ok())
+    {
+        parseBuffer(mf.view(), as);
+        return;
+    }
+
+    // Empty files, pipes and the like cannot be mapped.
+    std::ifstream f(fname);
+    std::string buf((std::istreambuf_iterator<char>(f)),
+                    std::istreambuf_iterator<char>());
+    parseBuffer(buf, as);
 }
 
 // Parse an Atomese string expression and return a Handle to the parsed atom
 Handle opencog::parseExpression(const std::string& expr, AtomSpace &as)
 {
-    std::istringstream sstream(expr);
-    return parseStream(sstream, as);
+    return parseBuffer(expr, as);
 }
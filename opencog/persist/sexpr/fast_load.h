@@ -34,6 +34,11 @@ namespace opencog
     void load_file(const std::string& file_name, AtomSpace&);
 
     Handle parseExpression(const std::string& expr, AtomSpace&);
+
+    /// Write the atoms of the given type, and their values, to a file
+    /// that load_file() can read back. The file is also valid scheme.
+    void dump_file(const std::string& file_name, AtomSpace&,
+                   Type t = ATOM, bool subclass = true);
 }
 
 #endif // FAST_LOAD_H
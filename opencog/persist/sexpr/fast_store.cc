@@ -0,0 +1,263 @@
+/*
+ * fast_store.cc
+ * Fast dump of the AtomSpace as Atomese s-expressions.
+ *
+ * Copyright (C) 2020 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include <opencog/util/oc_omp.h>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/execution/Executor.h>
+#include <opencog/atoms/truthvalue/TruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "fast_load.h"
+#include "Sexpr.h"
+
+using namespace opencog;
+
+namespace {
+
+/// Encodes atoms into one flat text buffer. A link that was already
+/// written into the buffer is copied from there, instead of being
+/// encoded all over again.
+class Encoder
+{
+    std::string& _out;
+    std::unordered_map<const Atom*, std::pair<size_t, size_t>> _done;
+    const Handle& _tvkey;
+
+    // Quotes and backslashes in the name are escaped, as in a scheme
+    // string; the loader undoes that.
+    void node(const Handle& h)
+    {
+        _out += '(';
+        _out += nameserver().getTypeName(h->get_type());
+        _out += " \"";
+        const std::string& name = h->get_name();
+        if (std::string::npos == name.find_first_of("\"\\"))
+            _out += name;
+        else
+            for (char c : name)
+            {
+                if ('"' == c or '\\' == c) _out += '\\';
+                _out += c;
+            }
+        _out += '"';
+    }
+
+    void number(double d)
+    {
+        char buf[40];
+        snprintf(buf, sizeof(buf), " %.16g", d);
+        _out += buf;
+    }
+
+    void stv(const TruthValuePtr& tv)
+    {
+        _out += "(stv";
+        number(tv->get_mean());
+        number(tv->get_confidence());
+        _out += ')';
+    }
+
+public:
+    Encoder(std::string& out, const Handle& tvkey) :
+        _out(out), _tvkey(tvkey) {}
+
+    /// Write the atom, with the given truth value inline, if any.
+    void atom(const Handle& h, const TruthValuePtr& tv = nullptr)
+    {
+        if (h->is_node())
+        {
+            node(h);
+            if (tv) { _out += ' '; stv(tv); }
+            _out += ')';
+            return;
+        }
+
+        if (nullptr == tv)
+        {
+            auto it = _done.find(h.operator->());
+            if (_done.end() != it)
+            {
+                _out.append(_out, it->second.first, it->second.second);
+                return;
+            }
+        }
+
+        size_t start = _out.size();
+        _out += '(';
+        _out += nameserver().getTypeName(h->get_type());
+        for (const Handle& ho : h->getOutgoingSet())
+        {
+            _out += ' ';
+            atom(ho);
+        }
+        if (tv)
+        {
+            _out += ' ';
+            stv(tv);
+            _out += ')';
+            return;
+        }
+        _out += ')';
+        _done.emplace(h.operator->(),
+                      std::make_pair(start, _out.size() - start));
+    }
+
+    /// Write the atom as a top-level expression, along with its values.
+    void entry(const Handle& h)
+    {
+        HandleSet keys(h->getKeys());
+        if (keys.empty())
+        {
+            atom(h);
+            _out += '\n';
+            return;
+        }
+
+        // A lone SimpleTruthValue is written inline, as usual.
+        if (1 == keys.size() and **keys.begin() == *_tvkey)
+        {
+            TruthValuePtr tv(h->getTruthValue());
+            if (SIMPLE_TRUTH_VALUE == tv->get_type())
+            {
+                atom(h, tv);
+                _out += '\n';
+                return;
+            }
+        }
+
+        _out += "(cog-set-values! ";
+        atom(h);
+        _out += " (list";
+        for (const Handle& k : keys)
+        {
+            _out += " (cons ";
+            atom(k);
+            _out += ' ';
+            ValuePtr v(h->getValue(k));
+            if (nullptr == v) _out += "#f";
+            else if (v->is_atom()) atom(HandleCast(v));
+            else if (SIMPLE_TRUTH_VALUE == v->get_type())
+                stv(TruthValueCast(v));
+            else _out += Sexpr::encode_value(v);
+            _out += ')';
+        }
+        _out += "))\n";
+    }
+};
+
+}
+
+/// dump_file -- write the atoms of the given type to the file.
+///
+/// Links are written out in full, so an atom that appears inside of
+/// another atom being written does not need an entry of its own,
+/// unless it has values. Each entry stands on its own, and so the
+/// entries can be loaded back in any order.
+///
+/// The entries are encoded in blocks, by several tasks at once on the
+/// shared executor, and the blocks are then written out in order.
+void opencog::dump_file(const std::string& fname, AtomSpace& as,
+                        Type t, bool subclass)
+{
+    std::ofstream f(fname, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (not f.is_open())
+       throw std::runtime_error("Cannot open file >>" + fname + "<<");
+
+    HandleSeq atoms;
+    as.get_handles_by_type(atoms, t, subclass);
+
+    UnorderedHandleSet inside;
+    for (const Handle& h : atoms)
+        if (h->is_link())
+            for (const Handle& ho : h->getOutgoingSet())
+                inside.insert(ho);
+
+    HandleSeq entries;
+    for (const Handle& h : atoms)
+        if (0 == inside.count(h) or h->haveValues())
+            entries.emplace_back(h);
+    inside.clear();
+    atoms.clear();
+
+    static const size_t BLOCK = 2048;
+    size_t nthreads = std::max((size_t) 1, (size_t) opencog::num_threads());
+    size_t nblocks = (entries.size() + BLOCK - 1) / BLOCK;
+
+    Handle tvkey(createNode(PREDICATE_NODE, "*-TruthValueKey-*"));
+
+    // Encode a batch of blocks in parallel, then write it out, then
+    // go on to the next batch. This bounds the memory used.
+    std::vector<std::string> bufs(4 * nthreads);
+    for (size_t first = 0; first < nblocks; first += bufs.size())
+    {
+        size_t last = std::min(nblocks, first + bufs.size());
+        std::atomic_size_t next(first);
+
+        auto encode = [&]()->void
+        {
+            try
+            {
+                for (size_t b = next++; b < last; b = next++)
+                {
+                    std::string& out = bufs[b - first];
+                    out.clear();
+                    Encoder enc(out, tvkey);
+                    size_t end = std::min(entries.size(), (b + 1) * BLOCK);
+                    for (size_t i = b * BLOCK; i < end; i++)
+                        enc.entry(entries[i]);
+                }
+            }
+            catch (...)
+            {
+                // Stop the others early.
+                next = last;
+                throw;
+            }
+        };
+
+        // The waiting thread runs whichever tasks no worker has
+        // picked up yet.
+        TaskGroup group;
+        size_t ntasks = std::min(nthreads, last - first);
+        for (size_t i = 0; i < ntasks; i++)
+            group.run(encode);
+        group.wait();
+
+        for (size_t b = first; b < last; b++)
+            f.write(bufs[b - first].data(), bufs[b - first].size());
+        if (f.fail())
+            throw std::runtime_error("Cannot write file >>" + fname + "<<");
+    }
+
+    f.close();
+    if (f.fail())
+        throw std::runtime_error("Cannot write file >>" + fname + "<<");
+}
@@ -28,6 +28,7 @@
 #include <opencog/atoms/execution/EvaluationLink.h>
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/atoms/core/FindUtils.h>
+#include <opencog/atoms/core/NumberNode.h>
 
 #include "InitiateSearchMixin.h"
 #include "PatternMatchEngine.h"
@@ -566,7 +567,11 @@ bool InitiateSearchMixin::legacy_search(PatternMatchCallback& pmc)
 		return pme.explore_constant_evaluatables(_pattern->pmandatory);
 	}
 
-	DO_LOG({logger().fine("Cannot use no-var search, use deep-type search");})
+	DO_LOG({logger().fine("Cannot use no-var search, use value-index search");})
+	if (setup_value_search(clauses))
+		return search_loop(pmc, "vvvvvvvvvv value_index_search vvvvvvvvvv");
+
+	DO_LOG({logger().fine("Cannot use value-index search, use deep-type search");})
 	if (setup_deep_type_search(clauses))
 		return search_loop(pmc, "dddddddddd deep_type_search ddddddddd");
 
@@ -661,8 +666,10 @@ static void all_starts(const Handle& h,
 	start_set.insert(h);
 	if (0 == depth) return;
 	depth--;
-	for (const Handle& hi : h->getIncomingSet())
+	h->visit_incoming([&](const Handle& hi)->bool {
 		all_starts(hi, depth, start_set);
+		return false;
+	});
 }
 
 // Find the first link type that is NOT a type specifier.
@@ -1032,6 +1039,132 @@ bool InitiateSearchMixin::setup_variable_search(const PatternTermSeq& clauses)
 	return true;
 }
 
+/* ======================================================== */
+/**
+ * Value-index search. If the pattern has a mandatory clause of the form
+ *
+ *    GreaterThanLink
+ *        ValueOfLink
+ *            VariableNode "$x"
+ *            SomeKey
+ *        NumberNode 42
+ *
+ * (or the same, with the arguments flipped) and the atomspace has a
+ * value index for the type of "$x" and for that key, then the search
+ * can start with just those atoms whose value lies in the range, and
+ * not with every atom of that type. The comparison clause is still
+ * evaluated for each grounding, in the usual way; the index merely
+ * narrows down the starting set.
+ *
+ * The variable must have exactly one simple type; otherwise atoms of
+ * the other types would be missed. Only the atoms in this atomspace
+ * are indexed, and so this is not used for nested atomspaces.
+ *
+ * The list of starting points is placed into `_search_set` and this
+ * method returns true. If there is no suitable index, this returns
+ * false.
+ */
+bool InitiateSearchMixin::setup_value_search(const PatternTermSeq& clauses)
+{
+	if (not _as->have_value_index() or _as->get_environ())
+		return false;
+
+	bool all_clauses_are_evaluatable = true;
+	for (const PatternTermPtr& cl : clauses)
+	{
+		if (cl->hasAnyEvaluatable()) continue;
+		all_clauses_are_evaluatable = false;
+		break;
+	}
+
+	size_t count = SIZE_MAX;
+	ValueIndexPtr best;
+	double thresh = 0.0;
+	bool above = true;
+
+	_root = PatternTerm::UNDEFINED;
+	_starter_term = PatternTerm::UNDEFINED;
+	for (const PatternTermPtr& cmp : _pattern->pmandatory)
+	{
+		const Handle& hcmp = cmp->getHandle();
+		if (GREATER_THAN_LINK != hcmp->get_type() or
+		    2 != hcmp->get_arity())
+			continue;
+
+		// One side must be a ValueOfLink, the other a NumberNode.
+		Handle vof(hcmp->getOutgoingAtom(0));
+		Handle num(hcmp->getOutgoingAtom(1));
+		bool gt = true;
+		if (VALUE_OF_LINK != vof->get_type())
+		{
+			std::swap(vof, num);
+			gt = false;
+		}
+		if (VALUE_OF_LINK != vof->get_type() or 2 != vof->get_arity() or
+		    NUMBER_NODE != num->get_type())
+			continue;
+
+		NumberNodePtr nn(NumberNodeCast(num));
+		if (1 != nn->size()) continue;
+
+		const Handle& var = vof->getOutgoingAtom(0);
+		const Handle& key = vof->getOutgoingAtom(1);
+		if (_variables->varset.end() == _variables->varset.find(var))
+			continue;
+
+		// The variable must be restricted to exactly one type.
+		const auto& tit = _variables->_typemap.find(var);
+		if (_variables->_typemap.end() == tit) continue;
+		const TypeSet& typeset = tit->second->get_simple_typeset();
+		if (1 != typeset.size() or
+		    0 < tit->second->get_deep_typeset().size())
+			continue;
+
+		ValueIndexPtr vidx(_as->get_value_index(*typeset.begin(), key));
+		if (nullptr == vidx) continue;
+
+		// Find a clause in which to start, at the variable.
+		PatternTermPtr root = PatternTerm::UNDEFINED;
+		PatternTermPtr starter = PatternTerm::UNDEFINED;
+		for (const PatternTermPtr& cl : clauses)
+		{
+			if (not all_clauses_are_evaluatable and
+			    cl->hasAnyEvaluatable()) continue;
+
+			starter = term_of_handle(var, cl);
+			if (PatternTerm::UNDEFINED == starter) continue;
+			root = cl;
+			break;
+		}
+		if (PatternTerm::UNDEFINED == root) continue;
+
+		double v = nn->get_value();
+		size_t num_in_range = gt ? vidx->count_greater(v)
+		                         : vidx->count_less(v);
+		if (num_in_range < count)
+		{
+			count = num_in_range;
+			best = vidx;
+			thresh = v;
+			above = gt;
+			_root = root;
+			_starter_term = starter;
+		}
+	}
+
+	if (nullptr == best) return false;
+
+	DO_LOG({LAZY_LOG_FINE << "Value-index search over " << count
+	                      << " atoms, starting at:\n"
+	                      << _root->to_full_string();})
+
+	if (above)
+		best->get_greater(_search_set, thresh);
+	else
+		best->get_less(_search_set, thresh);
+	return true;
+}
+
 /* ======================================================== */
 /**
  * No search -- no variables, only constant, possibly evaluatable
@@ -99,6 +99,7 @@ protected:
 	bool setup_deep_type_search(const PatternTermSeq&);
 	bool setup_link_type_search(const PatternTermSeq&);
 	bool setup_variable_search(const PatternTermSeq&);
+	bool setup_value_search(const PatternTermSeq&);
 
 	bool disjoin_search(PatternMatchCallback&, const PatternTermSeq&);
 	bool conjoin_search(PatternMatchCallback&, const PatternTermSeq&);
@@ -24,8 +24,11 @@
 #ifndef _OPENCOG_PATTERN_MATCH_CALLBACK_H
 #define _OPENCOG_PATTERN_MATCH_CALLBACK_H
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <set>
+#include <type_traits>
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/pattern/PatternLink.h>
@@ -292,6 +295,49 @@ class PatternMatchCallback
 			return h->getIncomingSetByType(t);
 		}
 
+		/**
+		 * Called whenever the incoming set of an atom is to be explored,
+		 * one link at a time. Each link of type `t` is handed to `cb`,
+		 * in order; if `cb` returns true, the walk stops, and true is
+		 * returned.
+		 *
+		 * The default walks over whatever get_incoming_set() returns,
+		 * so that callbacks that sort or limit the search space keep
+		 * working. Callbacks that do not need that may override this,
+		 * to avoid making a copy of the incoming set for every step
+		 * upwards; see TermMatchMixin.
+		 *
+		 * The visitor is a reference to the caller's lambda, and not a
+		 * copy of it: it is cheap to make and to call, and it is only
+		 * valid during the call.
+		 */
+		class IncomingVisitor
+		{
+			void* _obj;
+			bool (*_call)(void*, const Handle&);
+
+			public:
+				template<typename F, typename = typename std::enable_if<
+					not std::is_same<typename std::decay<F>::type,
+					                 IncomingVisitor>::value>::type>
+				IncomingVisitor(F&& f) :
+					_obj((void*) std::addressof(f)),
+					_call([](void* obj, const Handle& h)->bool {
+						return (*static_cast<typename
+							std::remove_reference<F>::type*>(obj))(h); })
+				{}
+
+				bool operator()(const Handle& h) const
+				{ return _call(_obj, h); }
+		};
+		virtual bool visit_incoming_set(const Handle& h, Type t,
+		                                const IncomingVisitor& cb)
+		{
+			for (const Handle& l : get_incoming_set(h, t))
+				if (cb(l)) return true;
+			return false;
+		}
+
 		virtual const TypeSet& get_connectives(void)
 		{ static const TypeSet _empty; return _empty; }
 
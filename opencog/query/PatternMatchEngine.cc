@@ -1331,27 +1331,25 @@ bool PatternMatchEngine::explore_upvar_branches(const PatternTermPtr& ptm,
 	// we have to explore the incoming set of the ground to see which
 	// (if any) of the incoming set satsisfies the parent term.
 
-	IncomingSet iset = _pmc.get_incoming_set(hg, t);
-	size_t sz = iset.size();
+	// The incoming set is walked in place, and not copied; on hub
+	// atoms, it can be huge.
 	DO_LOG({LAZY_LOG_FINE << "Looking upward at term = "
 	                      << parent->getQuote()->to_string() << std::endl
-	                      << "The grounded pivot point " << hg->to_string()
-	                      << " has " << sz << " branches";})
+	                      << "The grounded pivot point " << hg->to_string();})
 
 	// If there aren't any unordered links anywhere, just explore
 	// directly upwards.
+	DO_LOG(size_t i = 0;)
 	if (not ptm->hasUnorderedLink())
 	{
-		bool found = false;
-		for (size_t i = 0; i < sz; i++)
-		{
-			DO_LOG({LAZY_LOG_FINE << "Try upward branch " << i+1 << " of " << sz
-			                      << " at term=" << parent->to_string()
-			                      << " propose=" << iset[i]->to_string();})
+		bool found = _pmc.visit_incoming_set(hg, t,
+			[&](const Handle& hi)->bool {
+				DO_LOG({LAZY_LOG_FINE << "Try upward branch " << ++i
+				                      << " at term=" << parent->to_string()
+				                      << " propose=" << hi->to_string();})
 
-			found = explore_type_branches(parent, iset[i], clause);
-			if (found) break;
-		}
+				return explore_type_branches(parent, hi, clause);
+			});
 
 		logmsg("Found upward soln =", found);
 		return found;
@@ -1362,22 +1360,19 @@ bool PatternMatchEngine::explore_upvar_branches(const PatternTermPtr& ptm,
 	// the side and below us. Explore all of the differrent possible
 	// permutations.
 	_perm_breakout = _perm_to_step;
-	bool found = false;
-	for (size_t i = 0; i < sz; i++)
-	{
-		DO_LOG({LAZY_LOG_FINE << "Try upward permutable branch "
-		                      << i+1 << " of " << sz
-		                      << " at term=" << parent->to_string()
-		                      << " propose=" << iset[i]->to_string();})
-
-		_perm_odo.clear();
-		perm_push();
-		_perm_go_around = false;
-		found = explore_odometer(parent, iset[i], clause);
-		perm_pop();
-
-		if (found) break;
-	}
+	bool found = _pmc.visit_incoming_set(hg, t,
+		[&](const Handle& hi)->bool {
+			DO_LOG({LAZY_LOG_FINE << "Try upward permutable branch " << ++i
+			                      << " at term=" << parent->to_string()
+			                      << " propose=" << hi->to_string();})
+
+			_perm_odo.clear();
+			perm_push();
+			_perm_go_around = false;
+			bool fnd = explore_odometer(parent, hi, clause);
+			perm_pop();
+			return fnd;
+		});
 	_perm_breakout = nullptr;
 
 	logmsg("Found upward soln =", found);
@@ -1394,40 +1389,35 @@ bool PatternMatchEngine::explore_upglob_branches(const PatternTermPtr& ptm,
 {
 	const PatternTermPtr& parent(ptm->getParent());
 	Type t = parent->getHandle()->get_type();
-	IncomingSet iset;
-	if (nullptr == hg->getAtomSpace())
-		iset = _pmc.get_incoming_set(hg->getOutgoingAtom(0), t);
-	else
-		iset = _pmc.get_incoming_set(hg, t);
+	Handle hbase(nullptr == hg->getAtomSpace() ?
+	             hg->getOutgoingAtom(0) : hg);
 
-	size_t sz = iset.size();
 	DO_LOG({LAZY_LOG_FINE << "Looking globby upward for term = "
 	                      << parent->getQuote()->to_string() << std::endl
-	                      << "It's grounding " << hg->to_short_string()
-	                      << " has " << sz << " branches";})
+	                      << "It's grounding " << hg->to_short_string();})
 
 	// Move up the solution graph, looking for a match.
-	bool found = false;
-	for (size_t i = 0; i < sz; i++)
-	{
-		DO_LOG({LAZY_LOG_FINE << "Try upward branch " << i+1 << " of " << sz
-		                      << " for glob term=" << parent->to_string()
-		                      << " propose=" << iset[i]->id_to_string();})
-
-		// Before exploring the link branches, record the current
-		// _glob_state size.  The idea is, if the parent & iset[i] is a match,
-		// their state will be recorded in _glob_state, so that one can,
-		// if needed, resume and try to ground those globs again in a
-		// different way (e.g. backtracking from another branchpoint).
-		auto saved_glob_state = _glob_state;
-
-		found = explore_glob_branches(parent, iset[i], clause);
+	DO_LOG(size_t i = 0;)
+	bool found = _pmc.visit_incoming_set(hbase, t,
+		[&](const Handle& hi)->bool {
+			DO_LOG({LAZY_LOG_FINE << "Try upward branch " << ++i
+			                      << " for glob term=" << parent->to_string()
+			                      << " propose=" << hi->id_to_string();})
+
+			// Before exploring the link branches, record the current
+			// _glob_state size.  The idea is, if the parent & hi is a
+			// match, their state will be recorded in _glob_state, so
+			// that one can, if needed, resume and try to ground those
+			// globs again in a different way (e.g. backtracking from
+			// another branchpoint).
+			auto saved_glob_state = _glob_state;
 
-		// Restore the saved state, for the next go-around.
-		_glob_state = saved_glob_state;
+			bool fnd = explore_glob_branches(parent, hi, clause);
 
-		if (found) break;
-	}
+			// Restore the saved state, for the next go-around.
+			_glob_state = saved_glob_state;
+			return fnd;
+		});
 	logmsg("Found upward soln =", found);
 	return found;
 }
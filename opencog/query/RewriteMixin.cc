@@ -29,7 +29,8 @@
 using namespace opencog;
 
 RewriteMixin::RewriteMixin(AtomSpace* as)
-	: _as(as), inst(as), max_results(SIZE_MAX)
+	: _as(as), _num_results(0), _dedup_window(SIZE_MAX),
+	  inst(as), max_results(SIZE_MAX)
 {
 }
 
@@ -66,8 +67,9 @@ bool RewriteMixin::grounding(const GroundingMap &var_soln,
 		}
 	} catch (const SilentException& ex) {}
 
-	// If we found as many as we want, then stop looking for more.
-	return (_result_set.size() >= max_results);
+	// If we found as many as we want, or the reader of the stream
+	// doesn't want any more, then stop looking for more.
+	return (_num_results >= max_results) or _result_queue->is_halted();
 }
 
 void RewriteMixin::insert_result(ValuePtr v)
@@ -82,8 +84,27 @@ void RewriteMixin::insert_result(ValuePtr v)
 
 	if (_result_set.end() != _result_set.find(v)) return;
 
-	_result_set.insert(v);
-	_result_queue->push(std::move(v));
+	_num_results++;
+	if (nullptr == _stream)
+	{
+		_result_set.insert(v);
+		_result_queue->push(std::move(v));
+		return;
+	}
+
+	// When streaming, remember only the last few results, so that
+	// memory use does not grow with the number of results.
+	if (0 < _dedup_window)
+	{
+		_result_set.insert(v);
+		_recent.push_back(v);
+		if (_dedup_window < _recent.size())
+		{
+			_result_set.erase(_recent.front());
+			_recent.pop_front();
+		}
+	}
+	_result_queue->push_bounded(std::move(v));
 }
 
 bool RewriteMixin::start_search(void)
@@ -91,13 +112,16 @@ bool RewriteMixin::start_search(void)
 	// *Every* search gets a brand new, fresh queue!
 	// This allows users to hang on to the old queue, holding
 	// previous results, if they need to.
-	_result_queue = createQueueValue();
+	if (_stream)
+		_result_queue = _stream;
+	else
+		_result_queue = createQueueValue();
 	return false;
 }
 
 bool RewriteMixin::search_finished(bool done)
 {
-	_result_queue->close();
+	if (nullptr == _stream) _result_queue->close();
 	return done;
 }
 
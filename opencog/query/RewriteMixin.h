@@ -24,6 +24,7 @@
 #ifndef _OPENCOG_REWRITE_MIXIN_H
 #define _OPENCOG_REWRITE_MIXIN_H
 
+#include <deque>
 #include <vector>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -51,6 +52,12 @@ namespace opencog {
  * grounding.  A set of grounded expressions is created in 'result_set'.
  * Note that the callback may be called many times reporting the same
  * results. In that case the 'result_set' will contain unique solutions.
+ *
+ * If a stream is set, the results are written to it instead of to a
+ * fresh queue, and the writer blocks whenever the stream is full. The
+ * search stops once the reader halts the stream. A stream may run for
+ * a long time, and so only the most recent results are remembered, to
+ * skip repeats; see set_stream().
  */
 class RewriteMixin :
 	public virtual PatternMatchCallback
@@ -61,6 +68,13 @@ class RewriteMixin :
 		DECLARE_PE_MUTEX;
 		ValueSet _result_set;
 		QueueValuePtr _result_queue;
+		QueueValuePtr _stream;
+		size_t _num_results;
+
+		// When streaming, the results in _result_set, oldest first.
+		std::deque<ValuePtr> _recent;
+		size_t _dedup_window;
+
 		void insert_result(ValuePtr);
 
 	public:
@@ -77,6 +91,22 @@ class RewriteMixin :
 
 		virtual QueueValuePtr get_result_queue()
 		{ return _result_queue; }
+
+		/// Write results to the given, possibly bounded, queue. The
+		/// queue is not closed when the search finishes; the caller
+		/// does that, once it is done writing to it.
+		///
+		/// A result is skipped if it is the same as one of the last
+		/// `dedup_window` results written, atoms and other values
+		/// alike; older repeats are written again. This keeps the
+		/// memory used by the search bounded. Zero turns the skipping
+		/// off, and SIZE_MAX remembers all results, as when not
+		/// streaming.
+		static const size_t DEDUP_WINDOW = 4096;
+		void set_stream(const QueueValuePtr& qv,
+		                size_t dedup_window = DEDUP_WINDOW)
+		{ _stream = qv; _dedup_window = dedup_window; }
+		size_t num_results(void) const { return _num_results; }
 };
 
 }; // namespace opencog
@@ -94,6 +94,11 @@ class PMCGroundings : public SatisfyMixin
 		{
 			return _cb.get_incoming_set(h, t);
 		}
+		bool visit_incoming_set(const Handle& h, Type t,
+		                        const IncomingVisitor& cb)
+		{
+			return _cb.visit_incoming_set(h, t, cb);
+		}
 		void push(void) { _cb.push(); }
 		void pop(void) { _cb.pop(); }
 		void next_connections(const GroundingMap& var_grounding)
@@ -25,6 +25,7 @@
 #include <opencog/util/Logger.h>
 
 #include <opencog/atoms/core/FindUtils.h>
+#include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/core/Replacement.h>
 #include <opencog/atoms/core/StateLink.h>
 #include <opencog/atoms/execution/EvaluationLink.h>
@@ -549,6 +550,98 @@ IncomingSet TermMatchMixin::get_incoming_set(const Handle& h, Type t)
 	return h->getIncomingSetByType(t, _as);
 }
 
+bool TermMatchMixin::visit_incoming_set(const Handle& h, Type t,
+                                        const IncomingVisitor& cb)
+{
+	if (not visit_in_place)
+		return PatternMatchCallback::visit_incoming_set(h, t, cb);
+
+	if (nullptr == _as)
+		return h->visit_incoming_by_type(t, cb);
+
+	// Same as get_incoming_set(): skip links that are not visible
+	// from our atomspace.
+	const AtomTable* atab = &_as->get_atomtable();
+	return h->visit_incoming_by_type(t, [&](const Handle& l)->bool {
+		if (not atab->in_environ(l)) return false;
+		return cb(l);
+	});
+}
+
+/* ======================================================== */
+
+/// Get the value of a scalar NumberNode. Return false if the
+/// atom is not a NumberNode, or if it holds a vector.
+static bool scalar_value(const Handle& h, double& val)
+{
+	if (NUMBER_NODE != h->get_type()) return false;
+	NumberNodePtr nn(NumberNodeCast(h));
+	if (1 != nn->size()) return false;
+	val = nn->get_value();
+	return true;
+}
+
+/// Compute the numeric value of a term, looking up the groundings
+/// of its variables directly in the grounding map. This gives the
+/// same result as substituting the groundings into the term, and
+/// then executing it, but without creating any atoms along the way.
+///
+/// Only scalar NumberNodes, combined with PlusLink, MinusLink,
+/// TimesLink and DivideLink, are handled. For anything else (vectors,
+/// FloatValues, ExecutionOutputLinks, ...) false is returned, and the
+/// caller must fall back to the general case.
+static bool numeric_term(const Handle& term, const GroundingMap& gnds,
+                         double& val)
+{
+	// Substitution replaces any grounded term, not just variables.
+	GroundingMap::const_iterator gnd = gnds.find(term);
+	if (gnds.end() != gnd)
+		return scalar_value(gnd->second, val);
+
+	Type t = term->get_type();
+	if (NUMBER_NODE == t)
+		return scalar_value(term, val);
+
+	// The arithmetic links are right-folds, with the knil of zero or
+	// one. Follow the fold order exactly, so that the rounding is
+	// identical to that of FoldLink::delta_reduce().
+	if (PLUS_LINK == t or MINUS_LINK == t) val = 0.0;
+	else if (TIMES_LINK == t or DIVIDE_LINK == t) val = 1.0;
+	else return false;
+
+	const HandleSeq& oset = term->getOutgoingSet();
+	for (size_t i = oset.size(); 0 < i; i--)
+	{
+		double v;
+		if (not numeric_term(oset[i-1], gnds, v)) return false;
+
+		if (PLUS_LINK == t) val = v + val;
+		else if (MINUS_LINK == t) val = v - val;
+		else if (TIMES_LINK == t) val = v * val;
+		else val = v / val;
+	}
+	return true;
+}
+
+/// Evaluate a GreaterThanLink over arithmetic expressions, without
+/// building the grounded expression. Return false if this could not
+/// be done, in which case `result` is meaningless.
+static bool numeric_greater(const Handle& virt, const GroundingMap& gnds,
+                            bool& result)
+{
+	if (gnds.end() != gnds.find(virt)) return false;
+
+	const HandleSeq& oset = virt->getOutgoingSet();
+	if (2 != oset.size()) return false;
+
+	double v0, v1;
+	if (not numeric_term(oset[0], gnds, v0)) return false;
+	if (not numeric_term(oset[1], gnds, v1)) return false;
+
+	result = (v0 > v1);
+	return true;
+}
+
 /* ======================================================== */
 
 /// Evaluation of the link requires working with an atomspace of
@@ -558,9 +651,25 @@ IncomingSet TermMatchMixin::get_incoming_set(const Handle& h, Type t)
 /// the grounding might be insane.  So we put it here. This is
 /// not very efficient, but will do for now...
 ///
+/// Pure numeric comparisons are the exception: these are evaluated
+/// directly from the grounding map, without creating any atoms.
+///
 bool TermMatchMixin::eval_term(const Handle& virt,
                                const GroundingMap& gnds)
 {
+	Type vty = virt->get_type();
+	if (GREATER_THAN_LINK == vty)
+	{
+		bool gt;
+		if (numeric_greater(virt, gnds, gt))
+		{
+			DO_LOG({LAZY_LOG_FINE << "Eval_term numeric evaluation of "
+			              << virt->to_short_string()
+			              << " yielded " << gt << std::endl;})
+			return gt;
+		}
+	}
+
 	Handle gvirt(Replacement::replace_nocheck(virt, gnds));
 
 	DO_LOG({LAZY_LOG_FINE << "Enter eval_term CB with virt=" << std::endl
@@ -603,7 +712,6 @@ bool TermMatchMixin::eval_term(const Handle& virt,
 	//
 	// However, we also want to have a side-effect: the result of
 	// executing one of these things should be placed into the atomspace.
-	Type vty = virt->get_type();
 	if (EXECUTION_OUTPUT_LINK == vty or
 	    DEFINED_SCHEMA_NODE == vty or
 	    _nameserver.isA(vty, FUNCTION_LINK))
@@ -80,6 +80,17 @@ class TermMatchMixin : public virtual PatternMatchCallback
 
 		virtual IncomingSet get_incoming_set(const Handle&, Type);
 
+		/**
+		 * Walks the incoming set without copying it, if
+		 * `visit_in_place` is set; else, walks get_incoming_set(), as
+		 * the default does. It is off by default, so that subclasses
+		 * that override get_incoming_set() are still honoured; users
+		 * of classes that do not override it can turn it on.
+		 */
+		virtual bool visit_incoming_set(const Handle&, Type,
+		                                const IncomingVisitor&);
+		bool visit_in_place = false;
+
 		/**
 		 * Called when a virtual link is encountered. Returns false
 		 * to reject the match.
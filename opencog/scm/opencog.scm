@@ -23,6 +23,7 @@
 ; as otherwise guile generates warnings about "possibly unbound variable"
 ; when these are touched in the various scm files.
 (export
+cog-add-name-index!
 cog-arity
 cog-atom
 cog-atom?
@@ -33,10 +34,13 @@ cog-atomspace-clear
 cog-atomspace-cow!
 cog-atomspace-cow?
 cog-atomspace-env
+cog-atomspace-merge!
 cog-atomspace-readonly?
 cog-atomspace-ro!
 cog-atomspace-rw!
 cog-atomspace-uuid
+cog-bulk-set-value!
+cog-bulk-value
 cog-confidence
 cog-count
 cog-count-atoms
@@ -67,15 +71,22 @@ cog-new-node
 cog-new-value
 cog-node
 cog-node?
+cog-nodes-by-name
+cog-nodes-by-prefix
+cog-nodes-by-substring
 cog-number
 cog-outgoing-atom
 cog-outgoing-by-type
 cog-outgoing-set
+cog-partition-type
+cog-remove-name-index!
 cog-set-atomspace!
 cog-set-server-mode!
 cog-set-tv!
 cog-set-value!
 cog-set-values!
+cog-stream-halt!
+cog-stream-next
 cog-subtype?
 cog-tv
 cog-tv-confidence
@@ -85,6 +96,10 @@ cog-tv-merge
 cog-tv-merge-hi-conf
 cog-type
 cog-type->int
+cog-type-value-collect
+cog-type-value-count
+cog-type-value-filter
+cog-type-value-sum
 cog-value
 cog-value?
 cog-value->list
@@ -833,6 +833,40 @@
     See also: cog-set-value! ATOM KEY VALUE - set a single value
 ")
 
+(set-procedure-property! cog-bulk-value 'documentation
+"
+ cog-bulk-value ATOM-LIST KEY
+    Return a list of the values at KEY, one for each atom in ATOM-LIST,
+    in the same order. Atoms that have no value at KEY give #f.
+    This is the same as (map (lambda (a) (cog-value a KEY)) ATOM-LIST),
+    but much faster for long lists, as the values are fetched in C++,
+    using several threads.
+
+    Example:
+       guile> (cog-bulk-value
+                 (list (Concept \"a\") (Concept \"b\")) (Predicate \"key\"))
+
+    See also: cog-bulk-set-value! ATOM-LIST KEY VALUE-LIST
+")
+
+(set-procedure-property! cog-bulk-set-value! 'documentation
+"
+ cog-bulk-set-value! ATOM-LIST KEY VALUE-LIST
+    Set the value at KEY on each atom in ATOM-LIST, to the value in the
+    same position in VALUE-LIST. The two lists must be equally long.
+    A value of #f removes the KEY from that atom. Returns the list of
+    atoms; these differ from ATOM-LIST only if the atomspace is
+    copy-on-write, and some atoms had to be copied into it.
+
+    Example:
+       guile> (cog-bulk-set-value!
+                 (list (Concept \"a\") (Concept \"b\"))
+                 (Predicate \"key\")
+                 (list (FloatValue 1 2 3) (FloatValue 4 5 6)))
+
+    See also: cog-bulk-value ATOM-LIST KEY
+")
+
 (set-procedure-property! cog-value? 'documentation
 "
  cog-value? EXP
@@ -881,6 +915,31 @@
        3.0
 ")
 
+(set-procedure-property! cog-stream-next 'documentation
+"
+ cog-stream-next QUEUE
+    Return the next value in the QueueValue QUEUE, waiting for it to
+    arrive if need be. Return #f once the queue has been closed and
+    all of its values have been read.
+
+    Example:
+       guile> (use-modules (opencog exec))
+       guile> (define q (cog-execute-stream! query 100))
+       guile> (cog-stream-next q)
+
+    See also: cog-execute-stream!, cog-stream-halt!
+")
+
+(set-procedure-property! cog-stream-halt! 'documentation
+"
+ cog-stream-halt! QUEUE
+    Stop reading from the QueueValue QUEUE. Values still in the queue
+    are dropped. If a search is writing to the queue, it stops at its
+    next result.
+
+    See also: cog-execute-stream!, cog-stream-next
+")
+
 (set-procedure-property! cog-get-types 'documentation
 "
  cog-get-types
@@ -950,6 +1009,21 @@
   See also: cog-get-atoms TYPE - returns a list of atoms of TYPE.
 ")
 
+(set-procedure-property! cog-partition-type 'documentation
+"
+ cog-partition-type TYPE [NPARTS [ATOMSPACE]]
+    Return a list of lists, holding all of the atoms of type TYPE,
+    cut up into about NPARTS parts, for handing out to threads.
+    If NPARTS is absent or zero, a few parts per CPU are made. The
+    parts are a snapshot: atoms added later are not in them. As with
+    `cog-map-type`, sub-types of TYPE are not included.
+
+    The ATOMSPACE argument is optional; if absent, the default
+    AtomSpace for this thread is used.
+
+  See also: cog-par-map-reduce-type - map-reduce over these parts.
+")
+
 (set-procedure-property! cog-count-atoms 'documentation
 "
   cog-count-atoms ATOM-TYPE [ATOMSPACE] -- Count of number of atoms
@@ -964,6 +1038,146 @@
   will display a count of all atoms of type 'Concept
 ")
 
+(set-procedure-property! cog-type-value-count 'documentation
+"
+  cog-type-value-count TYPE KEY [ATOMSPACE]
+     Return a count of the number of atoms of type TYPE that have
+     some value attached at KEY.  The count is performed entirely in
+     C++, without creating a scheme object for each atom.
+
+     As with `cog-map-type`, sub-types of TYPE are not included.
+     The ATOMSPACE argument is optional; if absent, the default
+     AtomSpace for this thread is used.
+
+  Example:
+     (cog-type-value-count 'Concept (Predicate \"weight\"))
+
+  See also: cog-type-value-sum, cog-type-value-filter,
+     cog-type-value-collect, cog-count-atoms
+")
+
+(set-procedure-property! cog-type-value-sum 'documentation
+"
+  cog-type-value-sum TYPE KEY INDEX [ATOMSPACE]
+     Return the sum of the INDEX'th entry of the FloatValue located at
+     KEY, taken over all atoms of type TYPE.  Atoms that have no
+     FloatValue at KEY, or a FloatValue shorter than INDEX, are
+     skipped.  TruthValues are FloatValues, and so can be summed too.
+
+     The ATOMSPACE argument is optional; if absent, the default
+     AtomSpace for this thread is used.
+
+  Example:
+     ; Total of all counts on all ConceptNodes
+     (cog-type-value-sum 'Concept (Predicate \"counter\") 2)
+")
+
+(set-procedure-property! cog-type-value-filter 'documentation
+"
+  cog-type-value-filter TYPE KEY INDEX LO HI [ATOMSPACE]
+     Return a list of all atoms of type TYPE for which the INDEX'th
+     entry of the FloatValue located at KEY lies in the half-open
+     interval [LO, HI).  Use -inf.0 or +inf.0 for a one-sided bound.
+     The comparison is done in C++; only the matching atoms are
+     handed back to scheme.  The order of the list is not specified.
+
+     The ATOMSPACE argument is optional; if absent, the default
+     AtomSpace for this thread is used.
+
+  Example:
+     ; All words seen at least 100 times.
+     (cog-type-value-filter 'Word (Predicate \"counter\") 2 100 +inf.0)
+")
+
+(set-procedure-property! cog-type-value-collect 'documentation
+"
+  cog-type-value-collect TYPE KEY INDEX [ATOMSPACE]
+     Return a single FloatValue holding the INDEX'th entry of the
+     FloatValue at KEY, for every atom of type TYPE that has one.
+     The order of the entries is not specified; this is meant for
+     computing statistics (histograms, norms, and so on) over the
+     whole set.
+
+     The ATOMSPACE argument is optional; if absent, the default
+     AtomSpace for this thread is used.
+
+  Example:
+     (cog-value->list
+        (cog-type-value-collect 'Concept (Predicate \"weight\") 0))
+")
+
+(set-procedure-property! cog-add-name-index! 'documentation
+"
+  cog-add-name-index! TYPE [ATOMSPACE]
+     Maintain a sorted index of the names of all nodes of type TYPE.
+     This makes `cog-nodes-by-prefix` and `cog-nodes-by-name` fast
+     for that type, as they no longer need to look at every node.
+     The index is kept up to date as nodes are added and removed.
+     Only the nodes in ATOMSPACE itself are indexed, and not those
+     in any parent atomspace.  TYPE must be a Node type.
+
+     The ATOMSPACE argument is optional; if absent, the default
+     AtomSpace for this thread is used.
+
+  Example:
+     (cog-add-name-index! 'WordNode)
+
+  See also: cog-remove-name-index!, cog-nodes-by-prefix
+")
+
+(set-procedure-property! cog-remove-name-index! 'documentation
+"
+  cog-remove-name-index! TYPE [ATOMSPACE]
+     Stop maintaining the name index for nodes of type TYPE, if any.
+
+  See also: cog-add-name-index!
+")
+
+(set-procedure-property! cog-nodes-by-prefix 'documentation
+"
+  cog-nodes-by-prefix TYPE PREFIX [ATOMSPACE]
+     Return a list of all nodes of type TYPE whose name starts with
+     the string PREFIX.  If there is a name index for TYPE, the list
+     is sorted by name; otherwise all nodes of that type are examined,
+     and the order of the list is not specified.
+
+     The ATOMSPACE argument is optional; if absent, the default
+     AtomSpace for this thread is used.
+
+  Example:
+     (cog-nodes-by-prefix 'WordNode \"anti\")
+
+  See also: cog-add-name-index!, cog-nodes-by-substring,
+     cog-nodes-by-name
+")
+
+(set-procedure-property! cog-nodes-by-substring 'documentation
+"
+  cog-nodes-by-substring TYPE STRING [ATOMSPACE]
+     Return a list of all nodes of type TYPE whose name contains
+     STRING.  This always looks at every name; a name index makes
+     it cheaper, but does not avoid that.
+
+  Example:
+     (cog-nodes-by-substring 'WordNode \"ism\")
+
+  See also: cog-nodes-by-prefix
+")
+
+(set-procedure-property! cog-nodes-by-name 'documentation
+"
+  cog-nodes-by-name NAME [ATOMSPACE]
+     Return a list of all nodes, of any type, whose name is exactly
+     NAME.  Node types that have a name index are probed directly;
+     all other node types are scanned.
+
+  Example:
+     (cog-nodes-by-name \"cat\")
+     ; => ((ConceptNode \"cat\") (WordNode \"cat\"))
+
+  See also: cog-node, cog-nodes-by-prefix
+")
+
 (set-procedure-property! cog-atomspace 'documentation
 "
  cog-atomspace [ATOM]
@@ -1086,6 +1300,39 @@
          cog-atomspace-ro! and cog-atomspace-rw!,
 ")
 
+(set-procedure-property! cog-atomspace-merge! 'documentation
+"
+ cog-atomspace-merge! [ATOMSPACE]
+     Merge the contents of ATOMSPACE into its parent, and then clear
+     ATOMSPACE.  All atoms in ATOMSPACE are added to the parent; atoms
+     that the parent already holds get the values set in ATOMSPACE,
+     and lose the keys that were removed in ATOMSPACE.  Atoms that
+     ATOMSPACE copied from the parent, and then extracted, are also
+     extracted from the parent.
+
+     Together with cog-atomspace-cow!, this allows what-if reasoning:
+     creating a COW child copies nothing, and an atom is copied into
+     the child, with all of its values, when it is first changed
+     there. The child can then be either merged back, or simply
+     discarded. After merging, the child is empty, and can be used
+     again.
+
+     Throws if there is no parent, or if it is read-only.
+
+     The ATOMSPACE argument is optional; if not specified, the current
+     atomspace is assumed.
+
+  Example:
+     (define fork (cog-new-atomspace (cog-atomspace)))
+     (cog-atomspace-cow! #t fork)
+     (cog-set-atomspace! fork)
+     (cog-set-tv! (Concept \"A\") (stv 0.3 0.9))
+     (cog-set-atomspace! (cog-atomspace-env fork))
+     (cog-atomspace-merge! fork)
+
+     See also: cog-atomspace-cow!, cog-new-atomspace
+")
+
 (set-procedure-property! cog-atomspace-cow? 'documentation
 "
  cog-atomspace-cow? [ATOMSPACE]
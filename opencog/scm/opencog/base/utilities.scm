@@ -53,6 +53,7 @@
 ; -- cog-cp -- Copy list of atoms from one atomspace to another
 ; -- cog-cp-all -- Copy all atoms from one atomspace to another
 ; -- cog-get-all-subtypes -- Call recursively cog-get-subtypes
+; -- cog-par-map-reduce-type -- Parallel map-reduce over atoms of a type.
 ;
 ;;; Code:
 ; Copyright (c) 2008, 2013, 2014 Linas Vepstas <linasvepstas@gmail.com>
@@ -1172,4 +1173,29 @@
          (rec-subtypes (map cog-get-all-subtypes subtypes)))
     (delete-duplicates (append subtypes (apply append rec-subtypes)))))
 
+; -----------------------------------------------------------------------
+(define-public (cog-par-map-reduce-type MAP REDUCE INIT TYPE . ATOMSPACE)
+"
+ cog-par-map-reduce-type MAP REDUCE INIT TYPE [ATOMSPACE]
+    Apply MAP to every atom of type TYPE, and combine the results with
+    REDUCE, which is called as (REDUCE value accumulated).  The work is
+    distributed over the available CPU's, one part of the atomspace at
+    a time (see `cog-partition-type`).  INIT is the starting value for
+    each part, and so must be an identity for REDUCE (e.g. 0 for +).
+    REDUCE must be associative and commutative, as the atoms are not
+    visited in any particular order.
+
+    Example:
+       ; Sum of the lengths of the names of all ConceptNodes
+       (cog-par-map-reduce-type
+          (lambda (atom) (string-length (cog-name atom))) + 0 'Concept)
+"
+	(define (reduce-part part)
+		(fold (lambda (atom acc) (REDUCE (MAP atom) acc)) INIT part))
+
+	(fold REDUCE INIT
+		(par-map reduce-part
+			(apply cog-partition-type TYPE 0 ATOMSPACE)))
+)
+
 ; ---------------------------------------------------------------------
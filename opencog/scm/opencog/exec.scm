@@ -7,4 +7,19 @@
 (use-modules (opencog as-config))
 (load-extension (string-append opencog-ext-path-exec "libexec") "opencog_exec_init")
 
-(export cog-evaluate! cog-execute!)
+(export cog-evaluate! cog-execute! cog-execute-stream!)
+
+(set-procedure-property! cog-execute-stream! 'documentation
+"
+ cog-execute-stream! QUERY CAPACITY
+    Run the QueryLink (or BindLink) QUERY in a new thread, and return
+    a QueueValue that the results are written to, as they are found.
+    Read them with `cog-stream-next`. The search waits whenever
+    CAPACITY results are waiting to be read; zero means no limit.
+    Call `cog-stream-halt!` to stop the search early.
+
+    Example:
+       guile> (define q (cog-execute-stream! query 100))
+       guile> (let loop ((v (cog-stream-next q)))
+                 (when v (display v) (loop (cog-stream-next q))))
+")
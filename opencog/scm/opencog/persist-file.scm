@@ -11,7 +11,7 @@
 	(string-append opencog-ext-path-persist-file "libpersist-file")
 	"opencog_persist_file_init")
 
-(export load-file)
+(export dump-file load-file)
 
 (set-procedure-property! load-file 'documentation
 "
@@ -20,4 +20,11 @@
     Throws error if FILE does not exist.
 ")
 
+(set-procedure-property! dump-file 'documentation
+"
+ dump-file FILE -- Write all of the atoms in the AtomSpace, and their
+    values, to FILE, as Atomese. The file can be read back with
+    `load-file`.
+")
+
 ; --------------------------------------------------------------------
@@ -8,7 +8,7 @@
 (load-extension (string-append opencog-ext-path-python-scm "libPythonSCM")
 	"opencog_python_init")
 
-(export python-eval python-call-with-as)
+(export python-eval python-call-with-as python-set-concurrent!)
 
 (set-procedure-property! python-eval 'documentation
 "
@@ -42,3 +42,15 @@
       (python-call-with-as \"foo\" (cog-atomspace))
       (cog-node 'ConceptNode \"Apple\")
 ")
+
+(set-procedure-property! python-set-concurrent! 'documentation
+"
+ python-set-concurrent! BOOL
+    If BOOL is #t, then python functions called from GroundedSchema
+    and GroundedPredicate nodes may run in several threads at once;
+    if #f (the default), they are serialized by a global lock. The
+    python GIL is still taken, unless python was built free-threaded.
+    The python functions must be thread-safe, if this is enabled.
+
+    Example: (python-set-concurrent! #t)
+")
@@ -45,3 +45,14 @@
 (define wait-bad
 	(ThreadJoin (SequentialAnd
 		(EvaluationLink (GroundedPredicate "scm:insdfasdfascr") (List)))))
+
+; Leave a mark in whatever atomspace this runs in.
+(define (mark) (Concept "marked") (stv 1 1))
+
+(define mark-join
+	(ThreadJoin
+		(EvaluationLink (GroundedPredicate "scm:mark") (List))
+		(EvaluationLink (GroundedPredicate "scm:mark") (List))
+		(EvaluationLink (GroundedPredicate "scm:mark") (List))
+		(EvaluationLink (GroundedPredicate "scm:mark") (List))
+	))
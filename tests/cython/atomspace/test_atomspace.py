@@ -137,6 +137,99 @@ class AtomSpaceTest(TestCase):
         result = self.space.get_atoms_by_type(types.AnchorNode, subtype=False)
         self.assertEqual(len(result), 0)
 
+    def test_get_by_name(self):
+        w1 = ConceptNode("antigen")
+        w2 = ConceptNode("antibody")
+        w3 = ConceptNode("body")
+        p1 = PredicateNode("body")
+
+        # Results must be the same with and without the index.
+        for indexed in [False, True]:
+            if indexed:
+                self.space.add_name_index(types.ConceptNode)
+
+            result = self.space.get_nodes_by_prefix(types.ConceptNode, "anti")
+            self.assertEqual(set(result), set([w1, w2]))
+
+            result = self.space.get_nodes_by_substring(types.ConceptNode, "body")
+            self.assertEqual(set(result), set([w2, w3]))
+
+            result = self.space.get_nodes_by_name("body")
+            self.assertEqual(set(result), set([w3, p1]))
+
+        # The index follows additions and removals, and is sorted.
+        w4 = ConceptNode("antic")
+        self.space.remove(w1)
+        result = self.space.get_nodes_by_prefix(types.ConceptNode, "anti")
+        self.assertEqual(result, [w2, w4])
+
+        self.space.remove_name_index(types.ConceptNode)
+
+    def test_get_partitions_by_type(self):
+        nodes = [ConceptNode("part " + str(i)) for i in range(100)]
+        parts = self.space.get_partitions_by_type(types.ConceptNode,
+                                                  subtype=False, nparts=4)
+        self.assertTrue(len(parts) > 1)
+        flat = [atom for part in parts for atom in part]
+        self.assertEqual(len(flat), len(nodes))
+        self.assertEqual(set(flat), set(nodes))
+
+    def test_bulk_values(self):
+        atoms = [ConceptNode("bulk " + str(i)) for i in range(100)]
+        key = PredicateNode("bulk key")
+        values = [FloatValue([i, 2 * i]) for i in range(100)]
+        values[5] = None
+        values[9] = FloatValue(0.5)
+        self.space.set_values(atoms, key, values)
+        self.assertEqual(self.space.get_values(atoms, key), values)
+
+        table = self.space.get_float_values(atoms, key, missing=-1.0)
+        self.assertEqual((100, 2), table.shape)
+        rows = table.tolist()
+        self.assertEqual([3.0, 6.0], rows[3])
+        self.assertEqual([-1.0, -1.0], rows[5])
+        self.assertEqual([0.5, -1.0], rows[9])
+
+        # Rows of a 2-D buffer become FloatValues.
+        self.space.set_values(atoms[:2], key, table[1:3])
+        self.assertEqual(FloatValue([1.0, 2.0]), atoms[0].get_value(key))
+        self.assertEqual(FloatValue([2.0, 4.0]), atoms[1].get_value(key))
+
+        with self.assertRaises(RuntimeError):
+            self.space.set_values(atoms, key, values[:3])
+
+    def test_atom_ids(self):
+        a = ConceptNode("id a")
+        b = ConceptNode("id b")
+        self.assertEqual(None, self.space.get_atom_id(a))
+
+        self.space.enable_atom_ids()
+        aid = self.space.get_atom_id(a)
+        self.assertEqual(a, self.space.get_atom_by_id(aid))
+        self.assertTrue(aid < self.space.get_atom_id_bound())
+
+        ab = ListLink(a, b)
+        ba = ListLink(b, a)
+        graph = self.space.export_csr([types.ListLink, types.ConceptNode])
+        ids = list(graph['ids'])
+        self.assertEqual(4, len(ids))
+        self.assertEqual(sorted(ids), ids)
+        vert = dict((self.space.get_atom_by_id(i), v)
+                    for v, i in enumerate(ids))
+
+        def edges(kind, atom):
+            offs = graph[kind + '_offsets']
+            v = vert[atom]
+            return list(graph[kind + '_edges'][offs[v]:offs[v + 1]])
+
+        self.assertEqual([vert[a], vert[b]], edges('out', ab))
+        self.assertEqual([vert[b], vert[a]], edges('out', ba))
+        self.assertEqual([], edges('out', a))
+        self.assertEqual(sorted([vert[ab], vert[ba]]), edges('in', a))
+
+        self.space.disable_atom_ids()
+        self.assertEqual(None, self.space.get_atom_id(a))
+
     def test_incoming_by_type(self):
         a1 = Node("test1")
         a2 = ConceptNode("test2")
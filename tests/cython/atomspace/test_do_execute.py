@@ -3,7 +3,7 @@ import threading
 
 from opencog.atomspace import create_child_atomspace
 from opencog.type_constructors import *
-from opencog.execute import execute_atom
+from opencog.execute import execute_atom, execute_stream
 from opencog.utilities import initialize_opencog, finalize_opencog
 from opencog.utilities import push_default_atomspace, get_default_atomspace
 
@@ -60,6 +60,26 @@ class DoExecuteTest(unittest.TestCase):
             [test_as.add_node(types.ConceptNode, "cat"),
             test_as.add_node(types.ConceptNode, "animal")]))
 
+    def test_execute_stream(self):
+        animal = ConceptNode("animal")
+        for i in range(20):
+            InheritanceLink(ConceptNode("critter-" + str(i)), animal)
+        query = QueryLink(
+            TypedVariableLink(VariableNode("$x"), TypeNode("ConceptNode")),
+            InheritanceLink(VariableNode("$x"), animal),
+            VariableNode("$x"))
+
+        got = set(execute_stream(self.atomspace, query, 2))
+        self.assertEqual(20, len(got))
+
+        # Stop after the first few results.
+        got = []
+        for critter in execute_stream(self.atomspace, query, 2):
+            got.append(critter)
+            if len(got) == 3:
+                break
+        self.assertEqual(3, len(got))
+
     def test_threaded(self):
         """push default atomspace in different thread and check the behaviour"""
         test_as = AtomSpace()
@@ -1,4 +1,5 @@
 import unittest
+from array import array
 
 from opencog.type_constructors import *
 from opencog.utilities import initialize_opencog, finalize_opencog
@@ -53,3 +54,40 @@ class FloatValueTest(unittest.TestCase):
         self.assertFalse(value.is_atom())
         self.assertFalse(value.is_link())
         self.assertTrue(value.is_a(types.Value))
+
+    def test_buffer_view(self):
+        value = FloatValue([1.0, 2.0, 3.0])
+        view = memoryview(value)
+        self.assertEqual('d', view.format)
+        self.assertEqual((3,), view.shape)
+        self.assertTrue(view.readonly)
+        self.assertEqual([1.0, 2.0, 3.0], view.tolist())
+        self.assertEqual(3, len(value))
+
+    def test_buffer_outlives_value(self):
+        view = memoryview(FloatValue([4.0, 5.0]))
+        self.assertEqual([4.0, 5.0], view.tolist())
+
+    def test_create_from_buffer(self):
+        self.assertEqual(FloatValue([1.0, 2.5, 3.0]),
+                         FloatValue(array('d', [1.0, 2.5, 3.0])))
+        self.assertEqual(FloatValue([1.0, 2.0]), FloatValue(array('i', [1, 2])))
+        self.assertEqual(FloatValue([1.0, 3.0]),
+                         FloatValue(memoryview(array('d', [1.0, 2.0, 3.0]))[::2]))
+        self.assertEqual(0, len(FloatValue(array('d'))))
+
+    def test_truth_value_buffer(self):
+        tv = TruthValue(0.25, 0.5)
+        self.assertEqual([0.25, 0.5], memoryview(tv).tolist())
+
+    def test_numpy_round_trip(self):
+        try:
+            import numpy
+        except ImportError:
+            self.skipTest('numpy is not installed')
+        data = numpy.linspace(0.0, 1.0, 1000)
+        value = FloatValue(data)
+        view = numpy.asarray(value)
+        self.assertFalse(view.flags.writeable)
+        self.assertTrue(numpy.array_equal(data, view))
+        self.assertEqual(value, FloatValue(view))
@@ -8,6 +8,7 @@ from unittest import TestCase
 from opencog.type_constructors import *
 from opencog.atomspace import AtomSpace
 from opencog.utilities import initialize_opencog, finalize_opencog, load_file
+from opencog.utilities import dump_file
 
 __author__ = 'Curtis Faith'
 
@@ -52,6 +53,17 @@ class UtilitiesTest(TestCase):
             load_file(tmp_file, new_space1)
             self.assertTrue(len(new_space1) == 4)
 
+    def test_dump_file(self):
+        gen_atoms(self.atomspace, 10000)
+        with tempfile.TemporaryDirectory() as tmpdirname:
+            tmp_file = os.path.join(tmpdirname, 'dump.scm')
+            dump_file(tmp_file, self.atomspace)
+            new_space = AtomSpace()
+            load_file(tmp_file, new_space)
+            self.assertEqual(len(self.atomspace), len(new_space))
+            for atom in self.atomspace:
+                self.assertTrue(atom in new_space)
+
 
 def gen_name():
     tmp = []
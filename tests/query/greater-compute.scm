@@ -108,3 +108,39 @@
 		)
 	)
 )
+
+; Pure arithmetic; no black-box functions. This is evaluated directly
+; from the groundings, without building the grounded expression.
+;   true:  (3 * 10) - (10 / 2) = 25 > 20
+;   false: (3 * 8) - (8 / 2) = 20 > 20
+(define (arithmetic)
+	(BindLink
+		(VariableList
+			(VariableNode "$who")
+			(VariableNode "$how_much")
+		)
+		(AndLink
+			(EvaluationLink
+				(PredicateNode "ergs")
+				(ListLink
+					(VariableNode "$who")
+					(VariableNode "$how_much")
+				)
+			)
+			(GreaterThanLink
+				(MinusLink
+					(TimesLink
+						(NumberNode 3)
+						(VariableNode "$how_much")
+					)
+					(DivideLink
+						(VariableNode "$how_much")
+						(NumberNode 2)
+					)
+				)
+				(NumberNode 20)
+			)
+		)
+		(VariableNode "$who")
+	)
+)
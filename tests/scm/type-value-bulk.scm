@@ -0,0 +1,57 @@
+(use-modules (srfi srfi-1))
+(use-modules (opencog))
+(use-modules (opencog test-runner))
+
+(opencog-test-runner)
+
+(define tname "type-value-bulk")
+(test-begin tname)
+
+(define key (Predicate "weight"))
+
+; Ten concepts, with weights 0..9; two more with no weight at all.
+(for-each
+	(lambda (n)
+		(cog-set-value! (Concept (number->string n)) key
+			(FloatValue n (* 2 n))))
+	(iota 10))
+(Concept "unweighted")
+(cog-set-value! (Concept "short") key (FloatValue))
+
+; Sub-types and other types must be ignored.
+(cog-set-value! (Predicate "not-a-concept") key (FloatValue 100 100))
+
+(test-equal "count" 11 (cog-type-value-count 'Concept key))
+(test-equal "sum" 45.0 (cog-type-value-sum 'Concept key 0))
+(test-equal "sum second" 90.0 (cog-type-value-sum 'Concept key 1))
+(test-equal "sum out of range" 0.0 (cog-type-value-sum 'Concept key 5))
+
+(define mid (cog-type-value-filter 'Concept key 0 3 6))
+(test-equal "filter size" 3 (length mid))
+(test-assert "filter contents"
+	(every (lambda (c) (member c mid))
+		(list (Concept "3") (Concept "4") (Concept "5"))))
+(test-equal "filter open"
+	10 (length (cog-type-value-filter 'Concept key 0 -inf.0 +inf.0)))
+
+(define coll (cog-type-value-collect 'Concept key 1))
+(test-assert "collect is float" (cog-subtype? 'FloatValue (cog-type coll)))
+(test-equal "collect contents"
+	(map (lambda (n) (exact->inexact (* 2 n))) (iota 10))
+	(sort (cog-value->list coll) <))
+
+; Bulk get and set, over a list of atoms.
+(define some (list (Concept "1") (Concept "unweighted") (Concept "2")))
+(test-equal "bulk get"
+	(list (FloatValue 1 2) #f (FloatValue 2 4))
+	(cog-bulk-value some key))
+
+(define other-key (Predicate "other"))
+(test-equal "bulk set" some
+	(cog-bulk-set-value! some other-key
+		(list (FloatValue 7) (StringValue "x") #f)))
+(test-equal "bulk get set"
+	(list (FloatValue 7) (StringValue "x") #f)
+	(cog-bulk-value some other-key))
+
+(test-end tname)